@@ -0,0 +1,1228 @@
+/**
+ * @file btree.hpp
+ * @author ghan (ghan@student.42seoul.kr)
+ * @brief A header file for template B+ Tree class
+ * @date 2022-07-25
+ */
+
+#ifndef FT_CONTAINERS_INCLUDES_BTREE_HPP_
+#define FT_CONTAINERS_INCLUDES_BTREE_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <new>
+
+#include "iterator_traits.hpp"
+#include "type_traits.hpp"
+#include "utility.hpp"
+
+#define FT_NOEXCEPT_ throw()
+
+namespace ft {
+
+// SECTION : node sizing
+// A node aims at kBTreeNodeBytes (four cache lines) : as many slots as fit
+// next to its links, at least Min and at most 255
+enum { kBTreeNodeBytes = 256 };
+
+template <size_t SlotBytes, size_t LinkBytes, size_t Min>
+struct BTreeSlotCount {
+  enum {
+    kFit = (kBTreeNodeBytes > LinkBytes)
+               ? (kBTreeNodeBytes - LinkBytes) / SlotBytes
+               : 0,
+    value = (kFit < Min) ? Min : (kFit > 255 ? 255 : kFit)
+  };
+};
+
+// SECTION : slot arrays
+// Up to N elements of T, sorted, in raw storage of the node.
+// A new element is constructed at Vacant() first, then Place puts it at its
+// position : a throwing constructor leaves the array as it was.
+// Trivially copyable elements are kept sorted in place and shifted with
+// memmove. Others never move once constructed : a permutation of the slots
+// keeps them sorted, the free slots after the used ones.
+template <typename T, size_t N, bool Trivial = is_trivially_copyable<T>::value>
+class BTreeSlots;
+
+template <typename T, size_t N>
+class BTreeSlots<T, N, true> {
+ private:
+  union {
+    char bytes[N * sizeof(T)];
+    long double align_float;
+    void* align_ptr;
+    long align_int;
+  } storage_;
+  unsigned char size_;
+
+  T* Data_(void) { return reinterpret_cast<T*>(storage_.bytes); }
+
+  const T* Data_(void) const {
+    return reinterpret_cast<const T*>(storage_.bytes);
+  }
+
+ public:
+  BTreeSlots(void) : size_(0) {}
+
+  size_t Size(void) const { return size_; }
+
+  T* At(size_t i) { return Data_() + i; }
+
+  const T* At(size_t i) const { return Data_() + i; }
+
+  T* Vacant(void) { return Data_() + size_; }
+
+  // the element constructed at Vacant() goes to position pos
+  void Place(size_t pos) {
+    T* data = Data_();
+    if (pos != size_) {
+      char placed[sizeof(T)];
+      std::memcpy(placed, static_cast<void*>(data + size_), sizeof(T));
+      std::memmove(static_cast<void*>(data + pos + 1),
+                   static_cast<void*>(data + pos), (size_ - pos) * sizeof(T));
+      std::memcpy(static_cast<void*>(data + pos), placed, sizeof(T));
+    }
+    ++size_;
+  }
+
+  // the n elements from pos were destroyed
+  void Remove(size_t pos, size_t n = 1) {
+    T* data = Data_();
+    std::memmove(static_cast<void*>(data + pos),
+                 static_cast<void*>(data + pos + n),
+                 (size_ - pos - n) * sizeof(T));
+    size_ -= n;
+  }
+
+  // the element at pos was destroyed, the one constructed at Vacant() takes
+  // its position
+  void Replace(size_t pos) {
+    std::memcpy(static_cast<void*>(Data_() + pos),
+                static_cast<void*>(Data_() + size_), sizeof(T));
+  }
+};
+
+template <typename T, size_t N>
+class BTreeSlots<T, N, false> {
+ private:
+  union {
+    char bytes[N * sizeof(T)];
+    long double align_float;
+    void* align_ptr;
+    long align_int;
+  } storage_;
+  unsigned char size_;
+  unsigned char order_[N];
+
+  T* Data_(void) { return reinterpret_cast<T*>(storage_.bytes); }
+
+  const T* Data_(void) const {
+    return reinterpret_cast<const T*>(storage_.bytes);
+  }
+
+ public:
+  BTreeSlots(void) : size_(0) {
+    for (size_t i = 0; i < N; ++i) order_[i] = static_cast<unsigned char>(i);
+  }
+
+  size_t Size(void) const { return size_; }
+
+  T* At(size_t i) { return Data_() + order_[i]; }
+
+  const T* At(size_t i) const { return Data_() + order_[i]; }
+
+  T* Vacant(void) { return Data_() + order_[size_]; }
+
+  void Place(size_t pos) {
+    const unsigned char slot = order_[size_];
+    std::memmove(order_ + pos + 1, order_ + pos, size_ - pos);
+    order_[pos] = slot;
+    ++size_;
+  }
+
+  // the freed slots go right after the used ones
+  void Remove(size_t pos, size_t n = 1) {
+    unsigned char freed[N];
+    std::memcpy(freed, order_ + pos, n);
+    std::memmove(order_ + pos, order_ + pos + n, size_ - pos - n);
+    size_ -= n;
+    std::memcpy(order_ + size_, freed, n);
+  }
+
+  void Replace(size_t pos) {
+    const unsigned char slot = order_[pos];
+    order_[pos] = order_[size_];
+    order_[size_] = slot;
+  }
+};
+
+// SECTION : nodes
+// Elements live in the leaves only, which are linked in order. Inner nodes
+// hold separators : every key in children[i] is less than keys[i], and every
+// key in children[i + 1] is not.
+struct BTreeNodeBase {
+  BTreeNodeBase* parent;  // NULL at the root
+  bool is_leaf;
+
+  explicit BTreeNodeBase(bool leaf) : parent(NULL), is_leaf(leaf) {}
+};
+
+template <typename Value>
+struct BTreeLeaf : public BTreeNodeBase {
+  enum {
+    kSlots = BTreeSlotCount<sizeof(Value) + 1,
+                            sizeof(BTreeNodeBase) + 2 * sizeof(void*) + 1,
+                            4>::value
+  };
+
+  BTreeLeaf* prev;
+  BTreeLeaf* next;
+  BTreeSlots<Value, kSlots> values;
+
+  BTreeLeaf(void) : BTreeNodeBase(true), prev(NULL), next(NULL) {}
+};
+
+// one key slot more than kKeys, so that a new separator can always be
+// constructed before an old one is destroyed
+template <typename Key>
+struct BTreeInner : public BTreeNodeBase {
+  enum {
+    kKeys = BTreeSlotCount<sizeof(Key) + sizeof(void*) + 1,
+                           sizeof(BTreeNodeBase) + sizeof(void*) + 1,
+                           3>::value
+  };
+
+  BTreeSlots<Key, kKeys + 1> keys;
+  BTreeNodeBase* children[kKeys + 1];
+
+  BTreeInner(void) : BTreeNodeBase(false) {}
+
+  size_t Children(void) const { return keys.Size() + 1; }
+};
+
+// SECTION : iterators
+// A leaf & the index of the element in it. end() is one past the last
+// element of the last leaf.
+template <typename Value>
+class BTreeIterator;
+
+template <typename Value>
+class BTreeConstIterator {
+ private:
+  typedef BTreeLeaf<Value>* LeafPtr_;
+
+  LeafPtr_ leaf_;
+  size_t index_;
+
+ public:
+  typedef bidirectional_iterator_tag iterator_category;
+  typedef Value value_type;
+  typedef const Value& reference;
+  typedef const Value* pointer;
+  typedef ptrdiff_t difference_type;
+
+  // Constructors
+  BTreeConstIterator(void) : leaf_(NULL), index_(0) {}
+
+  BTreeConstIterator(LeafPtr_ leaf, size_t index)
+      : leaf_(leaf), index_(index) {}
+
+  BTreeConstIterator(const BTreeConstIterator& original)
+      : leaf_(original.leaf_), index_(original.index_) {}
+
+  BTreeConstIterator(const BTreeIterator<Value>& itr)
+      : leaf_(itr.base()), index_(itr.index()) {}
+
+  // Destructor
+  ~BTreeConstIterator(void) {}
+
+  // Copy Assignment operator overload
+  BTreeConstIterator& operator=(const BTreeConstIterator& rhs) {
+    leaf_ = rhs.leaf_;
+    index_ = rhs.index_;
+    return *this;
+  }
+
+  // dereference & reference
+  reference operator*(void) const { return *leaf_->values.At(index_); }
+
+  pointer operator->(void) const { return leaf_->values.At(index_); }
+
+  // increment & decrement
+  BTreeConstIterator& operator++(void) {
+    if (++index_ == leaf_->values.Size() && leaf_->next != NULL) {
+      leaf_ = leaf_->next;
+      index_ = 0;
+    }
+    return *this;
+  }
+
+  BTreeConstIterator operator++(int) {
+    BTreeConstIterator tmp = *this;
+    this->operator++();
+    return tmp;
+  }
+
+  BTreeConstIterator& operator--(void) {
+    if (index_ == 0) {
+      leaf_ = leaf_->prev;
+      index_ = leaf_->values.Size();
+    }
+    --index_;
+    return *this;
+  }
+
+  BTreeConstIterator operator--(int) {
+    BTreeConstIterator tmp = *this;
+    this->operator--();
+    return tmp;
+  }
+
+  LeafPtr_ base(void) const { return leaf_; }
+
+  size_t index(void) const { return index_; }
+};
+
+template <typename Value>
+class BTreeIterator {
+ private:
+  typedef BTreeLeaf<Value>* LeafPtr_;
+
+  LeafPtr_ leaf_;
+  size_t index_;
+
+ public:
+  typedef bidirectional_iterator_tag iterator_category;
+  typedef Value value_type;
+  typedef Value& reference;
+  typedef Value* pointer;
+  typedef ptrdiff_t difference_type;
+
+  // Constructors
+  BTreeIterator(void) : leaf_(NULL), index_(0) {}
+
+  BTreeIterator(LeafPtr_ leaf, size_t index) : leaf_(leaf), index_(index) {}
+
+  BTreeIterator(const BTreeIterator& original)
+      : leaf_(original.leaf_), index_(original.index_) {}
+
+  // Destructor
+  ~BTreeIterator(void) {}
+
+  // Assignment operator overload
+  BTreeIterator& operator=(const BTreeIterator& rhs) {
+    leaf_ = rhs.leaf_;
+    index_ = rhs.index_;
+    return *this;
+  }
+
+  // dereference & reference
+  reference operator*(void) const { return *leaf_->values.At(index_); }
+
+  pointer operator->(void) const { return leaf_->values.At(index_); }
+
+  // increment & decrement
+  BTreeIterator& operator++(void) {
+    if (++index_ == leaf_->values.Size() && leaf_->next != NULL) {
+      leaf_ = leaf_->next;
+      index_ = 0;
+    }
+    return *this;
+  }
+
+  BTreeIterator operator++(int) {
+    BTreeIterator tmp = *this;
+    this->operator++();
+    return tmp;
+  }
+
+  BTreeIterator& operator--(void) {
+    if (index_ == 0) {
+      leaf_ = leaf_->prev;
+      index_ = leaf_->values.Size();
+    }
+    --index_;
+    return *this;
+  }
+
+  BTreeIterator operator--(int) {
+    BTreeIterator tmp = *this;
+    this->operator--();
+    return tmp;
+  }
+
+  LeafPtr_ base(void) const { return leaf_; }
+
+  size_t index(void) const { return index_; }
+};
+
+template <typename Value>
+bool operator==(const BTreeConstIterator<Value>& lhs,
+                const BTreeConstIterator<Value>& rhs) {
+  return lhs.base() == rhs.base() && lhs.index() == rhs.index();
+}
+
+template <typename Value>
+bool operator!=(const BTreeConstIterator<Value>& lhs,
+                const BTreeConstIterator<Value>& rhs) {
+  return !(lhs == rhs);
+}
+
+template <typename Value>
+bool operator==(const BTreeIterator<Value>& lhs,
+                const BTreeIterator<Value>& rhs) {
+  return lhs.base() == rhs.base() && lhs.index() == rhs.index();
+}
+
+template <typename Value>
+bool operator!=(const BTreeIterator<Value>& lhs,
+                const BTreeIterator<Value>& rhs) {
+  return !(lhs == rhs);
+}
+
+template <typename Value>
+bool operator==(const BTreeConstIterator<Value>& lhs,
+                const BTreeIterator<Value>& rhs) {
+  return lhs.base() == rhs.base() && lhs.index() == rhs.index();
+}
+
+template <typename Value>
+bool operator!=(const BTreeConstIterator<Value>& lhs,
+                const BTreeIterator<Value>& rhs) {
+  return !(lhs == rhs);
+}
+
+template <typename Value>
+bool operator==(const BTreeIterator<Value>& lhs,
+                const BTreeConstIterator<Value>& rhs) {
+  return lhs.base() == rhs.base() && lhs.index() == rhs.index();
+}
+
+template <typename Value>
+bool operator!=(const BTreeIterator<Value>& lhs,
+                const BTreeConstIterator<Value>& rhs) {
+  return !(lhs == rhs);
+}
+
+// SECTION : B+ Tree
+// The same interface as RbTree, for btree_map & btree_set. A lookup touches
+// one node per level, and the keys of a node are next to each other : a
+// linear scan of a few cache lines instead of a cache miss per comparison.
+// Every insert & erase may move the elements of the leaves involved, which
+// invalidates the iterators to them.
+// Full inner nodes are split on the way down, so that a leaf split always
+// finds room in its parent. Each step builds its new node (and constructs
+// its new separator) before it changes anything : a throwing copy leaves the
+// tree as it was. Erasures rebalance the same way, and stop where a copy
+// throws, with nodes left less than half full.
+template <typename Value, typename KeyOfValue, typename Compare,
+          typename Alloc = std::allocator<Value> >
+class BTree {
+ public:
+  typedef Alloc AllocType;
+  typedef Value ValueType;
+  typedef Value* ValuePtr;
+  typedef Value& ValueRef;
+  typedef typename KeyOfValue::KeyType KeyType;
+  typedef typename remove_cv<KeyType>::type SeparatorType;
+  typedef BTreeLeaf<ValueType> Leaf;
+  typedef BTreeInner<SeparatorType> Inner;
+  typedef BTreeNodeBase* BasePtr;
+  typedef BTreeIterator<ValueType> iterator;
+  typedef BTreeConstIterator<ValueType> const_iterator;
+  typedef reverse_iterator<const_iterator> const_reverse_iterator;
+  typedef reverse_iterator<iterator> reverse_iterator;
+  typedef size_t size_type;
+
+ private:
+  typedef typename AllocType::template rebind<Leaf>::other AllocLeaf_;
+  typedef typename AllocType::template rebind<Inner>::other AllocInner_;
+  typedef typename AllocType::template rebind<SeparatorType>::other AllocKey_;
+
+  enum { kLeafSlots_ = Leaf::kSlots, kInnerKeys_ = Inner::kKeys };
+
+  BasePtr root_;
+  Leaf* first_;
+  Leaf* last_;
+  Compare comp_;
+  AllocType alloc_;  // constructs the values in the leaves
+  size_type size_;
+
+ public:
+  // Constructors
+  BTree(const Compare& comp = Compare(), const AllocType& alloc = AllocType())
+      : root_(NULL),
+        first_(NULL),
+        last_(NULL),
+        comp_(comp),
+        alloc_(alloc),
+        size_(0) {}
+
+  // Copy constructor (Deep copy)
+  BTree(const BTree& original)
+      : root_(NULL),
+        first_(NULL),
+        last_(NULL),
+        comp_(original.comp_),
+        alloc_(original.alloc_),
+        size_(0) {
+    CopyFrom_(original);
+  }
+
+  BTree& operator=(const BTree& rhs) {
+    if (this == &rhs) return *this;
+    Clear();
+    comp_ = rhs.comp_;
+    CopyFrom_(rhs);
+    return *this;
+  }
+
+  // Destructor
+  ~BTree(void) { Clear(); }
+
+ private:
+  // SECTION : node utils
+  static const KeyType& KeyOf_(const ValueType& value) {
+    return KeyOfValue()(value);
+  }
+
+  static const KeyType& Key_(const Leaf* leaf, size_type i) {
+    return KeyOf_(*leaf->values.At(i));
+  }
+
+  static Inner* AsInner_(BasePtr node) { return static_cast<Inner*>(node); }
+
+  static Leaf* AsLeaf_(BasePtr node) { return static_cast<Leaf*>(node); }
+
+  Leaf* NewLeaf_(void) {
+    Leaf* leaf = AllocLeaf_(alloc_).allocate(1);
+    return ::new (static_cast<void*>(leaf)) Leaf;
+  }
+
+  Inner* NewInner_(void) {
+    Inner* inner = AllocInner_(alloc_).allocate(1);
+    return ::new (static_cast<void*>(inner)) Inner;
+  }
+
+  void DeleteLeaf_(Leaf* leaf) { AllocLeaf_(alloc_).deallocate(leaf, 1); }
+
+  void DeleteInner_(Inner* inner) {
+    AllocInner_(alloc_).deallocate(inner, 1);
+  }
+
+  void ConstructKey_(SeparatorType* ptr, const SeparatorType& key) {
+    AllocKey_(alloc_).construct(ptr, key);
+  }
+
+  void DestroyKey_(SeparatorType* ptr) { AllocKey_(alloc_).destroy(ptr); }
+
+  // destroys the values (or keys) from i on, then forgets them
+  void TruncateLeaf_(Leaf* leaf, size_type i) {
+    const size_type n = leaf->values.Size();
+    for (size_type j = i; j < n; ++j) alloc_.destroy(leaf->values.At(j));
+    leaf->values.Remove(i, n - i);
+  }
+
+  void TruncateInner_(Inner* inner, size_type i) {
+    const size_type n = inner->keys.Size();
+    for (size_type j = i; j < n; ++j) DestroyKey_(inner->keys.At(j));
+    inner->keys.Remove(i, n - i);
+  }
+
+  // the position of node among the children of its parent
+  static size_type ChildIndex_(const BasePtr node) {
+    const Inner* parent = AsInner_(node->parent);
+    size_type c = 0;
+    while (parent->children[c] != node) ++c;
+    return c;
+  }
+
+  // children are inserted after, and removed after, their separator
+  static void InsertChild_(Inner* inner, size_type c, BasePtr child) {
+    const size_type n = inner->keys.Size();  // children before insertion
+    std::memmove(inner->children + c + 1, inner->children + c,
+                 (n - c) * sizeof(BasePtr));
+    inner->children[c] = child;
+    child->parent = inner;
+  }
+
+  static void RemoveChild_(Inner* inner, size_type c) {
+    const size_type n = inner->keys.Size() + 2;  // children before removal
+    std::memmove(inner->children + c, inner->children + c + 1,
+                 (n - c - 1) * sizeof(BasePtr));
+  }
+
+  void FreeSubtree_(BasePtr node) {
+    if (node->is_leaf) {
+      TruncateLeaf_(AsLeaf_(node), 0);
+      DeleteLeaf_(AsLeaf_(node));
+      return;
+    }
+    Inner* inner = AsInner_(node);
+    for (size_type c = 0; c < inner->Children(); ++c)
+      FreeSubtree_(inner->children[c]);
+    TruncateInner_(inner, 0);
+    DeleteInner_(inner);
+  }
+
+  // SECTION : search utils
+  // keys are scanned linearly : a node holds a few cache lines of them
+  template <typename K>
+  size_type ChildFor_(const Inner* inner, const K& key) const {
+    const size_type n = inner->keys.Size();
+    size_type i = 0;
+    while (i < n && !comp_(key, *inner->keys.At(i))) ++i;
+    return i;
+  }
+
+  template <typename K>
+  Leaf* FindLeaf_(const K& key) const {
+    BasePtr node = root_;
+    while (!node->is_leaf)
+      node = AsInner_(node)->children[ChildFor_(AsInner_(node), key)];
+    return AsLeaf_(node);
+  }
+
+  template <typename K>
+  size_type LowerIndex_(const Leaf* leaf, const K& key) const {
+    const size_type n = leaf->values.Size();
+    size_type i = 0;
+    while (i < n && comp_(Key_(leaf, i), key)) ++i;
+    return i;
+  }
+
+  template <typename K>
+  size_type UpperIndex_(const Leaf* leaf, const K& key) const {
+    const size_type n = leaf->values.Size();
+    size_type i = 0;
+    while (i < n && !comp_(key, Key_(leaf, i))) ++i;
+    return i;
+  }
+
+  // one past the last element of a leaf is the first of the next one
+  iterator Normalize_(Leaf* leaf, size_type i) const {
+    if (i == leaf->values.Size() && leaf->next != NULL)
+      return iterator(leaf->next, 0);
+    return iterator(leaf, i);
+  }
+
+  // one past the last element, as a mutable iterator for the const lookups
+  iterator End_(void) const {
+    return iterator(last_, last_ == NULL ? 0 : last_->values.Size());
+  }
+
+  // SECTION : insert utils
+  // element makers : make(alloc, ptr) constructs an element at ptr
+  struct CopyValue_ {
+    const ValueType& value;
+
+    explicit CopyValue_(const ValueType& v) : value(v) {}
+
+    void operator()(AllocType& alloc, ValuePtr ptr) const {
+      alloc.construct(ptr, value);
+    }
+  };
+
+  template <typename Maker>
+  void AppendMade_(Leaf* leaf, const Maker& make) {
+    make(alloc_, leaf->values.Vacant());
+    leaf->values.Place(leaf->values.Size());
+  }
+
+  template <typename Maker>
+  iterator EmplaceInLeaf_(Leaf* leaf, size_type pos, const Maker& make) {
+    make(alloc_, leaf->values.Vacant());
+    leaf->values.Place(pos);
+    ++size_;
+    return iterator(leaf, pos);
+  }
+
+  // the first element goes into a single leaf root
+  template <typename Maker>
+  iterator EmplaceFirst_(const Maker& make) {
+    Leaf* leaf = NewLeaf_();
+    try {
+      AppendMade_(leaf, make);
+    } catch (...) {
+      DeleteLeaf_(leaf);
+      throw;
+    }
+    root_ = leaf;
+    first_ = leaf;
+    last_ = leaf;
+    size_ = 1;
+    return iterator(leaf, 0);
+  }
+
+  // a new root above the current one, without any separator yet
+  void GrowRoot_(void) {
+    Inner* root = NewInner_();
+    root->children[0] = root_;
+    root_->parent = root;
+    root_ = root;
+  }
+
+  // splits the full c-th child of inner (not full) in two, its middle
+  // separator going up to inner
+  void SplitInner_(Inner* inner, size_type c) {
+    Inner* full = AsInner_(inner->children[c]);
+    const size_type n = full->keys.Size();
+    const size_type mid = n / 2;
+    Inner* fresh = NewInner_();
+    SeparatorType* up = inner->keys.Vacant();
+    try {
+      ConstructKey_(up, *full->keys.At(mid));
+    } catch (...) {
+      DeleteInner_(fresh);
+      throw;
+    }
+    try {
+      for (size_type i = mid + 1; i < n; ++i) {
+        ConstructKey_(fresh->keys.Vacant(), *full->keys.At(i));
+        fresh->keys.Place(fresh->keys.Size());
+      }
+    } catch (...) {
+      TruncateInner_(fresh, 0);
+      DeleteInner_(fresh);
+      DestroyKey_(up);
+      throw;
+    }
+    for (size_type i = mid + 1; i <= n; ++i) {
+      fresh->children[i - mid - 1] = full->children[i];
+      full->children[i]->parent = fresh;
+    }
+    TruncateInner_(full, mid);
+    inner->keys.Place(c);
+    InsertChild_(inner, c + 1, fresh);
+  }
+
+  // descends to the leaf of key, splitting the full inner nodes on the way
+  template <typename K>
+  Leaf* DescendSplitting_(const K& key) {
+    if (!root_->is_leaf &&
+        AsInner_(root_)->keys.Size() == static_cast<size_type>(kInnerKeys_)) {
+      GrowRoot_();
+      SplitInner_(AsInner_(root_), 0);
+    }
+    BasePtr node = root_;
+    while (!node->is_leaf) {
+      Inner* inner = AsInner_(node);
+      size_type c = ChildFor_(inner, key);
+      BasePtr child = inner->children[c];
+      if (!child->is_leaf && AsInner_(child)->keys.Size() ==
+                                 static_cast<size_type>(kInnerKeys_)) {
+        SplitInner_(inner, c);
+        c = ChildFor_(inner, key);
+        child = inner->children[c];
+      }
+      node = child;
+    }
+    return AsLeaf_(node);
+  }
+
+  // Splits the full leaf, whose parent has room, with the new element at
+  // pos. The new leaf takes the half of the new element : the upper one
+  // after the old leaf, or the lower one before it. An element appended to
+  // the last leaf starts a new leaf alone, which keeps ascending fills full.
+  template <typename Maker>
+  iterator SplitLeaf_(Leaf* leaf, size_type pos, const KeyType& key,
+                      const Maker& make) {
+    if (leaf == root_) GrowRoot_();
+    Inner* parent = AsInner_(leaf->parent);
+    const size_type c = ChildIndex_(leaf);
+    const size_type n = leaf->values.Size();
+    const bool append = (leaf == last_ && pos == n);
+    const bool upper = append || pos >= n / 2;
+    const size_type from = append ? n : (upper ? n / 2 : 0);
+    const size_type to = upper ? n : n / 2;
+    Leaf* fresh = NewLeaf_();
+    SeparatorType* separator = parent->keys.Vacant();
+    try {
+      if (!upper)
+        ConstructKey_(separator, Key_(leaf, to));
+      else if (pos == from)
+        ConstructKey_(separator, key);
+      else
+        ConstructKey_(separator, Key_(leaf, from));
+    } catch (...) {
+      DeleteLeaf_(fresh);
+      throw;
+    }
+    try {
+      for (size_type i = from; i < to; ++i) {
+        if (i == pos) AppendMade_(fresh, make);
+        AppendMade_(fresh, CopyValue_(*leaf->values.At(i)));
+      }
+      if (pos == to) AppendMade_(fresh, make);
+    } catch (...) {
+      TruncateLeaf_(fresh, 0);
+      DeleteLeaf_(fresh);
+      DestroyKey_(separator);
+      throw;
+    }
+    for (size_type i = from; i < to; ++i) alloc_.destroy(leaf->values.At(i));
+    leaf->values.Remove(from, to - from);
+    parent->keys.Place(c);
+    if (upper) {
+      InsertChild_(parent, c + 1, fresh);
+      LinkAfter_(leaf, fresh);
+    } else {
+      InsertChild_(parent, c, fresh);
+      LinkBefore_(leaf, fresh);
+    }
+    ++size_;
+    return iterator(fresh, pos - from);
+  }
+
+  void LinkAfter_(Leaf* leaf, Leaf* fresh) {
+    fresh->prev = leaf;
+    fresh->next = leaf->next;
+    if (leaf->next != NULL)
+      leaf->next->prev = fresh;
+    else
+      last_ = fresh;
+    leaf->next = fresh;
+  }
+
+  void LinkBefore_(Leaf* leaf, Leaf* fresh) {
+    fresh->next = leaf;
+    fresh->prev = leaf->prev;
+    if (leaf->prev != NULL)
+      leaf->prev->next = fresh;
+    else
+      first_ = fresh;
+    leaf->prev = fresh;
+  }
+
+  // SECTION : delete utils
+  void UnlinkLeaf_(Leaf* leaf) {
+    if (leaf->prev != NULL)
+      leaf->prev->next = leaf->next;
+    else
+      first_ = leaf->next;
+    if (leaf->next != NULL)
+      leaf->next->prev = leaf->prev;
+    else
+      last_ = leaf->prev;
+  }
+
+  // removes an empty node with no copy : its parent loses it & a separator,
+  // and goes as well if that was its only child. Returns the node that lost
+  // a child.
+  Inner* RemoveEmpty_(BasePtr node) {
+    Inner* parent = AsInner_(node->parent);
+    const size_type c = ChildIndex_(node);
+    if (node->is_leaf) {
+      UnlinkLeaf_(AsLeaf_(node));
+      DeleteLeaf_(AsLeaf_(node));
+    } else {
+      DeleteInner_(AsInner_(node));
+    }
+    if (parent->keys.Size() == 0) return RemoveEmpty_(parent);
+    const size_type k = (c == 0) ? 0 : c - 1;
+    DestroyKey_(parent->keys.At(k));
+    parent->keys.Remove(k);
+    RemoveChild_(parent, c);
+    return parent;
+  }
+
+  // the position of the element after an erased one, kept up to date while
+  // the rebalance moves it
+  struct Tracked_ {
+    Leaf* leaf;
+    size_type index;
+  };
+
+  // Refills a leaf less than half full from a sibling : the two merge if
+  // they fit in one leaf, otherwise the leaf borrows one element
+  void RebalanceLeaf_(Leaf* leaf, Tracked_* tracked) {
+    Inner* parent = AsInner_(leaf->parent);
+    if (parent->keys.Size() == 0) return;
+    const size_type c = ChildIndex_(leaf);
+    const bool has_right = (c + 1 < parent->Children());
+    Leaf* left = has_right ? leaf : AsLeaf_(parent->children[c - 1]);
+    Leaf* right = has_right ? AsLeaf_(parent->children[c + 1]) : leaf;
+    const size_type k = has_right ? c : c - 1;  // their separator
+    const size_type n_left = left->values.Size();
+    const size_type n_right = right->values.Size();
+    if (n_left + n_right <= static_cast<size_type>(kLeafSlots_)) {
+      MergeLeaves_(left, right, k, tracked);
+      return;
+    }
+    SeparatorType* separator = parent->keys.Vacant();
+    if (has_right) {
+      // right's first goes to the end of leaf
+      ConstructKey_(separator, Key_(right, 1));
+      try {
+        AppendMade_(leaf, CopyValue_(*right->values.At(0)));
+      } catch (...) {
+        DestroyKey_(separator);
+        throw;
+      }
+      alloc_.destroy(right->values.At(0));
+      right->values.Remove(0);
+      if (tracked->leaf == right) {
+        if (tracked->index == 0)
+          tracked->leaf = leaf;
+        tracked->index = (tracked->index == 0) ? n_left : tracked->index - 1;
+      }
+    } else {
+      // left's last goes to the front of leaf
+      ConstructKey_(separator, Key_(left, n_left - 1));
+      try {
+        CopyValue_(*left->values.At(n_left - 1))(alloc_, leaf->values.Vacant());
+      } catch (...) {
+        DestroyKey_(separator);
+        throw;
+      }
+      leaf->values.Place(0);
+      alloc_.destroy(left->values.At(n_left - 1));
+      left->values.Remove(n_left - 1);
+      if (tracked->leaf == leaf) ++tracked->index;
+    }
+    DestroyKey_(parent->keys.At(k));
+    parent->keys.Replace(k);
+  }
+
+  // right's elements are appended to left, then right goes
+  void MergeLeaves_(Leaf* left, Leaf* right, size_type k, Tracked_* tracked) {
+    Inner* parent = AsInner_(left->parent);
+    const size_type n_left = left->values.Size();
+    const size_type n_right = right->values.Size();
+    try {
+      for (size_type i = 0; i < n_right; ++i)
+        AppendMade_(left, CopyValue_(*right->values.At(i)));
+    } catch (...) {
+      TruncateLeaf_(left, n_left);
+      throw;
+    }
+    if (tracked->leaf == right) {
+      tracked->leaf = left;
+      tracked->index += n_left;
+    }
+    TruncateLeaf_(right, 0);
+    UnlinkLeaf_(right);
+    DeleteLeaf_(right);
+    DestroyKey_(parent->keys.At(k));
+    parent->keys.Remove(k);
+    RemoveChild_(parent, k + 1);
+    RebalanceInner_(parent);
+  }
+
+  // the same for inner nodes, whose separator in the parent comes down
+  // between them on a merge, or rotates through the parent on a borrow
+  void RebalanceInner_(Inner* inner) {
+    if (inner == root_) {
+      if (inner->keys.Size() == 0) {
+        root_ = inner->children[0];
+        root_->parent = NULL;
+        DeleteInner_(inner);
+      }
+      return;
+    }
+    if (inner->keys.Size() >= static_cast<size_type>(kInnerKeys_) / 2) return;
+    Inner* parent = AsInner_(inner->parent);
+    if (parent->keys.Size() == 0) return;
+    const size_type c = ChildIndex_(inner);
+    const bool has_right = (c + 1 < parent->Children());
+    Inner* left = has_right ? inner : AsInner_(parent->children[c - 1]);
+    Inner* right = has_right ? AsInner_(parent->children[c + 1]) : inner;
+    const size_type k = has_right ? c : c - 1;
+    const size_type n_left = left->keys.Size();
+    const size_type n_right = right->keys.Size();
+    if (n_left + n_right + 1 <= static_cast<size_type>(kInnerKeys_)) {
+      MergeInners_(left, right, k);
+      return;
+    }
+    SeparatorType* down = inner->keys.Vacant();
+    ConstructKey_(down, *parent->keys.At(k));
+    SeparatorType* up = parent->keys.Vacant();
+    try {
+      ConstructKey_(up, has_right ? *right->keys.At(0)
+                                  : *left->keys.At(n_left - 1));
+    } catch (...) {
+      DestroyKey_(down);
+      throw;
+    }
+    if (has_right) {
+      inner->keys.Place(n_left);
+      inner->children[n_left + 1] = right->children[0];
+      right->children[0]->parent = inner;
+      DestroyKey_(right->keys.At(0));
+      right->keys.Remove(0);
+      std::memmove(right->children, right->children + 1,
+                   (n_right) * sizeof(BasePtr));
+    } else {
+      inner->keys.Place(0);
+      InsertChild_(inner, 0, left->children[n_left]);
+      DestroyKey_(left->keys.At(n_left - 1));
+      left->keys.Remove(n_left - 1);
+    }
+    DestroyKey_(parent->keys.At(k));
+    parent->keys.Replace(k);
+  }
+
+  void MergeInners_(Inner* left, Inner* right, size_type k) {
+    Inner* parent = AsInner_(left->parent);
+    const size_type n_left = left->keys.Size();
+    const size_type n_right = right->keys.Size();
+    try {
+      ConstructKey_(left->keys.Vacant(), *parent->keys.At(k));
+      left->keys.Place(n_left);
+      for (size_type i = 0; i < n_right; ++i) {
+        ConstructKey_(left->keys.Vacant(), *right->keys.At(i));
+        left->keys.Place(left->keys.Size());
+      }
+    } catch (...) {
+      TruncateInner_(left, n_left);
+      throw;
+    }
+    for (size_type i = 0; i <= n_right; ++i) {
+      left->children[n_left + 1 + i] = right->children[i];
+      right->children[i]->parent = left;
+    }
+    TruncateInner_(right, 0);
+    DeleteInner_(right);
+    DestroyKey_(parent->keys.At(k));
+    parent->keys.Remove(k);
+    RemoveChild_(parent, k + 1);
+    RebalanceInner_(parent);
+  }
+
+  // SECTION : copy
+  // the elements are appended in order, each one at the end of the last
+  // leaf, with no comparison
+  void CopyFrom_(const BTree& src) {
+    try {
+      for (const Leaf* leaf = src.first_; leaf != NULL; leaf = leaf->next)
+        for (size_type i = 0; i < leaf->values.Size(); ++i)
+          Append_(*leaf->values.At(i));
+    } catch (...) {
+      Clear();
+      throw;
+    }
+  }
+
+  void Append_(const ValueType& value) {
+    if (root_ == NULL) {
+      EmplaceFirst_(CopyValue_(value));
+      return;
+    }
+    const size_type n = last_->values.Size();
+    if (n < static_cast<size_type>(kLeafSlots_)) {
+      EmplaceInLeaf_(last_, n, CopyValue_(value));
+      return;
+    }
+    const KeyType& key = KeyOf_(value);
+    Leaf* leaf = DescendSplitting_(key);
+    SplitLeaf_(leaf, leaf->values.Size(), key, CopyValue_(value));
+  }
+
+  // unique insertion by key, the element is only made on a miss
+  template <typename Maker>
+  pair<iterator, bool> InsertUnique_(const KeyType& key, const Maker& make) {
+    if (root_ == NULL) return ft::make_pair(EmplaceFirst_(make), true);
+    Leaf* leaf = FindLeaf_(key);
+    size_type pos = LowerIndex_(leaf, key);
+    if (pos < leaf->values.Size() && !comp_(key, Key_(leaf, pos)))
+      return ft::make_pair(iterator(leaf, pos), false);
+    if (leaf->values.Size() < static_cast<size_type>(kLeafSlots_))
+      return ft::make_pair(EmplaceInLeaf_(leaf, pos, make), true);
+    leaf = DescendSplitting_(key);
+    pos = LowerIndex_(leaf, key);
+    return ft::make_pair(SplitLeaf_(leaf, pos, key, make), true);
+  }
+
+  // The key is checked against the hint and its neighbour : O(1) when it
+  // goes right there, in a leaf with room, O(log n) otherwise
+  template <typename Maker>
+  pair<iterator, bool> InsertUnique_(const KeyType& key, const Maker& make,
+                                     const_iterator hint) {
+    if (root_ == NULL) return InsertUnique_(key, make);
+    Leaf* leaf = hint.base();
+    size_type pos = hint.index();
+    const size_type n = leaf->values.Size();
+    const bool room = (n < static_cast<size_type>(kLeafSlots_));
+    if (pos == n) {
+      // end()
+      if (room && comp_(Key_(leaf, n - 1), key))
+        return ft::make_pair(EmplaceInLeaf_(leaf, n, make), true);
+      return InsertUnique_(key, make);
+    }
+    if (comp_(key, Key_(leaf, pos))) {
+      // before the hint, within the leaf or at the very front
+      if (room && ((pos == 0 && leaf == first_) ||
+                   (pos != 0 && comp_(Key_(leaf, pos - 1), key))))
+        return ft::make_pair(EmplaceInLeaf_(leaf, pos, make), true);
+      return InsertUnique_(key, make);
+    }
+    if (comp_(Key_(leaf, pos), key)) {
+      // after the hint, within the leaf or at the very end
+      ++pos;
+      if (room && ((pos == n && leaf == last_) ||
+                   (pos != n && comp_(key, Key_(leaf, pos)))))
+        return ft::make_pair(EmplaceInLeaf_(leaf, pos, make), true);
+      return InsertUnique_(key, make);
+    }
+    // equivalent to the hint
+    return ft::make_pair(iterator(leaf, pos), false);
+  }
+
+ public:
+  void Clear(void) {
+    if (root_ != NULL) FreeSubtree_(root_);
+    root_ = NULL;
+    first_ = NULL;
+    last_ = NULL;
+    size_ = 0;
+  }
+
+  // search
+  template <typename K>
+  iterator Search(const K& key) const {
+    iterator it = LowerBound(key);
+    if (it == End_() || comp_(key, KeyOf_(*it))) return End_();
+    return it;
+  }
+
+  // insert
+  pair<iterator, bool> Insert(const ValueType& value) {
+    return InsertUnique_(KeyOf_(value), CopyValue_(value));
+  }
+
+  // hinted insert
+  pair<iterator, bool> Insert(const ValueType& value, const_iterator hint) {
+    return InsertUnique_(KeyOf_(value), CopyValue_(value), hint);
+  }
+
+  // emplace
+  // Looks key up first, and only on a miss constructs the element in its
+  // leaf with make(alloc, ptr), which must give it an equivalent key
+  template <typename Maker>
+  pair<iterator, bool> Emplace(const KeyType& key, const Maker& make) {
+    return InsertUnique_(key, make);
+  }
+
+  template <typename Maker>
+  pair<iterator, bool> Emplace(const KeyType& key, const Maker& make,
+                               const_iterator hint) {
+    return InsertUnique_(key, make, hint);
+  }
+
+  // range
+  // each element is tried at the end first, so that sorted input is
+  // appended in O(1) amortized per element
+  template <typename InputIterator>
+  void InsertRange(InputIterator first, InputIterator last) {
+    for (; first != last; ++first) Insert(*first, end());
+  }
+
+  template <typename InputIterator>
+  void InsertSortedUnique(InputIterator first, InputIterator last) {
+    InsertRange(first, last);
+  }
+
+  // delete
+  // returns the element after the erased one, wherever the rebalance moved
+  // it
+  iterator Delete(const_iterator position) {
+    Leaf* leaf = position.base();
+    const size_type pos = position.index();
+    alloc_.destroy(leaf->values.At(pos));
+    leaf->values.Remove(pos);
+    if (--size_ == 0) {
+      Clear();
+      return end();
+    }
+    if (leaf == root_) return Normalize_(leaf, pos);
+    Tracked_ tracked = {leaf, pos};
+    try {
+      if (leaf->values.Size() == 0) {
+        // e.g. the single element of a leaf started by an append
+        tracked.leaf = leaf->next;
+        RebalanceInner_(RemoveEmpty_(leaf));
+      } else if (leaf->values.Size() <
+                 static_cast<size_type>(kLeafSlots_) / 2) {
+        RebalanceLeaf_(leaf, &tracked);
+      }
+    } catch (...) {
+      // a copy threw : the tree stays valid, with a node less than half full
+    }
+    if (tracked.leaf == NULL) return end();
+    return Normalize_(tracked.leaf, tracked.index);
+  }
+
+  // erases [first, last), the whole tree is cleared in one pass
+  void DeleteRange(const_iterator first, const_iterator last) {
+    if (first == begin() && last == end()) {
+      Clear();
+      return;
+    }
+    size_type n = 0;
+    for (const_iterator it = first; it != last; ++it) ++n;
+    for (; n > 0; --n) first = Delete(first);
+  }
+
+  // iterators
+  iterator begin(void) FT_NOEXCEPT_ { return iterator(first_, 0); }
+
+  const_iterator begin(void) const FT_NOEXCEPT_ {
+    return const_iterator(first_, 0);
+  }
+
+  iterator end(void) FT_NOEXCEPT_ { return End_(); }
+
+  const_iterator end(void) const FT_NOEXCEPT_ { return const_iterator(End_()); }
+
+  reverse_iterator rbegin(void) FT_NOEXCEPT_ { return reverse_iterator(end()); }
+
+  const_reverse_iterator rbegin(void) const FT_NOEXCEPT_ {
+    return const_reverse_iterator(end());
+  }
+
+  reverse_iterator rend(void) FT_NOEXCEPT_ {
+    return reverse_iterator(begin());
+  }
+
+  const_reverse_iterator rend(void) const FT_NOEXCEPT_ {
+    return const_reverse_iterator(begin());
+  }
+
+  // Operations
+  template <typename K>
+  iterator LowerBound(const K& key) const {
+    if (root_ == NULL) return End_();
+    Leaf* leaf = FindLeaf_(key);
+    return Normalize_(leaf, LowerIndex_(leaf, key));
+  }
+
+  template <typename K>
+  iterator UpperBound(const K& key) const {
+    if (root_ == NULL) return End_();
+    Leaf* leaf = FindLeaf_(key);
+    return Normalize_(leaf, UpperIndex_(leaf, key));
+  }
+
+  // getter
+  size_type GetSize(void) const { return size_; }
+
+  // swap
+  // nodes only point to each other, never to the tree
+  void Swap(BTree& x) {
+    std::swap(root_, x.root_);
+    std::swap(first_, x.first_);
+    std::swap(last_, x.last_);
+    std::swap(comp_, x.comp_);
+    std::swap(alloc_, x.alloc_);
+    std::swap(size_, x.size_);
+  }
+
+  // max allocation size
+  size_type MaxSize(void) const { return alloc_.max_size(); }
+};
+}  // namespace ft
+
+#endif
@@ -0,0 +1,410 @@
+/**
+ * @file btree_map.hpp
+ * @author ghan (ghan@student.42seoul.kr)
+ * @brief A header file for btree_map container
+ * @date 2022-07-25
+ */
+
+#ifndef FT_CONTAINERS_INCLUDES_BTREE_MAP_HPP_
+#define FT_CONTAINERS_INCLUDES_BTREE_MAP_HPP_
+
+#define FT_NOEXCEPT_ throw()
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <new>
+
+#include "algorithm.hpp"
+#include "btree.hpp"
+#include "iterator_traits.hpp"
+#include "rbtree.hpp"
+#include "utility.hpp"
+
+namespace ft {
+// btree_map is map over a B+ tree (see BTree) : faster lookups & scans,
+// but insert & erase invalidate the iterators to the elements they move
+template <typename Key, typename Value, typename Compare = std::less<Key>,
+          typename Alloc = std::allocator<pair<const Key, Value> > >
+class btree_map {
+ public:
+  typedef Key key_type;
+  typedef Value mapped_type;
+  typedef pair<const key_type, mapped_type> value_type;
+
+  class value_compare {
+    friend class btree_map;
+
+   private:
+    Compare v_comp_;
+    value_compare(Compare c) : v_comp_(c) {}
+
+   public:
+    bool operator()(const value_type& x, const value_type& y) const {
+      return v_comp_(x.first, y.first);
+    }
+  };
+
+  typedef Compare key_compare;
+  typedef typename Alloc::template rebind<value_type>::other allocator_type;
+  typedef typename allocator_type::reference reference;
+  typedef typename allocator_type::const_reference const_reference;
+  typedef typename allocator_type::pointer pointer;
+  typedef typename allocator_type::const_pointer const_pointer;
+
+ private:
+  typedef BTree<value_type, RbTreeSelectFirst<value_type>, key_compare,
+                allocator_type>
+      Base_;
+
+  // the return type R of a lookup by a key of type K, if Compare is
+  // transparent (depends on K, so that it is a substitution failure)
+  template <typename K, typename R>
+  struct IfTransparent_
+      : public enable_if<has_is_transparent<Compare>::value, R> {};
+
+  // makers for Base_::Emplace : build the value of a new element in place, from
+  // the key and either nothing (mapped_type is value-initialized) or one
+  // argument for mapped_type's constructor
+  struct MakeDefault_ {
+    const key_type& key;
+
+    explicit MakeDefault_(const key_type& k) : key(k) {}
+
+    void operator()(allocator_type&, pointer ptr) const {
+      ::new (static_cast<void*>(ptr)) value_type(piecewise_construct, key);
+    }
+  };
+
+  template <typename Arg>
+  struct MakeFrom_ {
+    const key_type& key;
+    const Arg& arg;
+
+    MakeFrom_(const key_type& k, const Arg& a) : key(k), arg(a) {}
+
+    void operator()(allocator_type&, pointer ptr) const {
+      ::new (static_cast<void*>(ptr))
+          value_type(piecewise_construct, key, arg);
+    }
+  };
+
+  key_compare comp_;
+  allocator_type alloc_;
+  Base_ tree_;
+
+ public:
+  typedef typename Base_::iterator iterator;
+  typedef typename Base_::const_iterator const_iterator;
+  typedef typename Base_::const_reverse_iterator const_reverse_iterator;
+  typedef typename Base_::reverse_iterator reverse_iterator;
+  typedef typename iterator_traits<iterator>::difference_type difference_type;
+  typedef size_t size_type;
+
+  // Constructors
+  // #1 empty : empty container with no element
+  explicit btree_map(const key_compare& comp = key_compare(),
+                     const allocator_type& alloc = allocator_type())
+      : comp_(comp), alloc_(alloc), tree_(comp, alloc) {}
+
+  // #2 range : construct with as many elements as the range [first, last)
+  template <typename InputIterator>
+  btree_map(InputIterator first,
+            typename enable_if<is_input_iterator<InputIterator>::value,
+                               InputIterator>::type last,
+            const key_compare& comp = key_compare(),
+            const allocator_type& alloc = allocator_type())
+      : comp_(comp), alloc_(alloc), tree_(comp, alloc) {
+    tree_.InsertRange(first, last);
+  }
+
+  // #2' sorted range (ft only) : [first, last) is sorted & unique, each
+  // element is appended in O(1) amortized
+  template <typename InputIterator>
+  btree_map(sorted_unique_t, InputIterator first,
+            typename enable_if<is_input_iterator<InputIterator>::value,
+                               InputIterator>::type last,
+            const key_compare& comp = key_compare(),
+            const allocator_type& alloc = allocator_type())
+      : comp_(comp), alloc_(alloc), tree_(comp, alloc) {
+    tree_.InsertSortedUnique(first, last);
+  }
+
+  // #3 copy constructor
+  btree_map(const btree_map& original)
+      : comp_(original.comp_),
+        alloc_(original.alloc_),
+        tree_(original.tree_) {}
+
+  // Destructor
+  ~btree_map(void) FT_NOEXCEPT_ {}
+
+  // Assignment operator overload
+  btree_map& operator=(const btree_map& rhs) {
+    comp_ = rhs.comp_;
+    alloc_ = rhs.alloc_;
+    tree_ = rhs.tree_;
+    return *this;
+  }
+
+  // Iterators
+  iterator begin(void) FT_NOEXCEPT_ { return tree_.begin(); }
+
+  const_iterator begin(void) const FT_NOEXCEPT_ { return tree_.begin(); }
+
+  iterator end(void) FT_NOEXCEPT_ { return tree_.end(); }
+
+  const_iterator end(void) const FT_NOEXCEPT_ { return tree_.end(); }
+
+  reverse_iterator rbegin(void) FT_NOEXCEPT_ { return tree_.rbegin(); }
+
+  const_reverse_iterator rbegin(void) const FT_NOEXCEPT_ {
+    return tree_.rbegin();
+  }
+
+  reverse_iterator rend(void) FT_NOEXCEPT_ { return tree_.rend(); }
+
+  const_reverse_iterator rend(void) const FT_NOEXCEPT_ { return tree_.rend(); }
+
+  // Capacity
+  bool empty(void) const FT_NOEXCEPT_ { return (tree_.GetSize() == 0); }
+
+  size_type size(void) const FT_NOEXCEPT_ { return tree_.GetSize(); }
+
+  size_type max_size(void) const FT_NOEXCEPT_ { return tree_.MaxSize(); }
+
+  // Element Access
+  // looks key up first : a hit constructs nothing, a miss value-initializes
+  // the mapped value right in its leaf
+  mapped_type& operator[](const key_type& key) {
+    return tree_.Emplace(key, MakeDefault_(key)).first->second;
+  }
+
+  // Modifiers
+  // single element
+  pair<iterator, bool> insert(const value_type& val) {
+    return tree_.Insert(val);
+  }
+
+  // single element at a given position
+  // O(1) when val goes right before or after position, in a leaf with room
+  iterator insert(iterator position, const value_type& val) {
+    return tree_.Insert(val, position).first;
+  }
+
+  // range
+  template <typename InputIterator>
+  void insert(InputIterator first,
+              typename enable_if<is_input_iterator<InputIterator>::value,
+                                 InputIterator>::type last) {
+    tree_.InsertRange(first, last);
+  }
+
+  // sorted range : [first, last) is sorted & unique (ft only)
+  template <typename InputIterator>
+  void insert(sorted_unique_t, InputIterator first,
+              typename enable_if<is_input_iterator<InputIterator>::value,
+                                 InputIterator>::type last) {
+    tree_.InsertSortedUnique(first, last);
+  }
+
+  // try_emplace (ft only, C++17 with at most one argument for mapped_type)
+  // Nothing is constructed if key is already there, otherwise the mapped
+  // value is built from arg in its leaf, without a temporary
+  pair<iterator, bool> try_emplace(const key_type& key) {
+    return tree_.Emplace(key, MakeDefault_(key));
+  }
+
+  template <typename Arg>
+  pair<iterator, bool> try_emplace(const key_type& key, const Arg& arg) {
+    return tree_.Emplace(key, MakeFrom_<Arg>(key, arg));
+  }
+
+  iterator try_emplace(iterator hint, const key_type& key) {
+    return tree_.Emplace(key, MakeDefault_(key), hint).first;
+  }
+
+  template <typename Arg>
+  iterator try_emplace(iterator hint, const key_type& key, const Arg& arg) {
+    return tree_.Emplace(key, MakeFrom_<Arg>(key, arg), hint).first;
+  }
+
+  // insert_or_assign (ft only, C++17) : the mapped value of a hit is assigned
+  // obj, a miss builds it from obj in its leaf
+  template <typename M>
+  pair<iterator, bool> insert_or_assign(const key_type& key, const M& obj) {
+    pair<iterator, bool> ret = tree_.Emplace(key, MakeFrom_<M>(key, obj));
+    if (!ret.second) ret.first->second = obj;
+    return ret;
+  }
+
+  template <typename M>
+  iterator insert_or_assign(iterator hint, const key_type& key, const M& obj) {
+    pair<iterator, bool> ret =
+        tree_.Emplace(key, MakeFrom_<M>(key, obj), hint);
+    if (!ret.second) ret.first->second = obj;
+    return ret.first;
+  }
+
+  // sigle element at a given position
+  void erase(iterator position) { tree_.Delete(position); }
+
+  // single element with a given key
+  size_type erase(const key_type& key) {
+    iterator position = find(key);
+    if (position == end()) return 0;
+    erase(position);
+    return 1;
+  }
+
+  // range
+  void erase(iterator first, iterator last) {
+    tree_.DeleteRange(first, last);
+  }
+
+  // the comparator & allocator go with the elements
+  void swap(btree_map& x) {
+    tree_.Swap(x.tree_);
+    std::swap(comp_, x.comp_);
+    std::swap(alloc_, x.alloc_);
+  }
+
+  void clear(void) FT_NOEXCEPT_ { tree_.Clear(); }
+
+  // Observers
+  key_compare key_comp(void) const { return comp_; }
+
+  value_compare value_comp(void) const { return value_compare(comp_); }
+
+  // Operations
+  // keys are compared as they are, with no value_type built around them
+  iterator find(const key_type& k) { return tree_.Search(k); }
+
+  const_iterator find(const key_type& k) const { return tree_.Search(k); }
+
+  size_type count(const key_type& k) const {
+    return tree_.Search(k) == end() ? 0 : 1;
+  }
+
+  iterator lower_bound(const key_type& key) { return tree_.LowerBound(key); }
+
+  const_iterator lower_bound(const key_type& key) const {
+    return tree_.LowerBound(key);
+  }
+
+  iterator upper_bound(const key_type& key) { return tree_.UpperBound(key); }
+
+  const_iterator upper_bound(const key_type& key) const {
+    return tree_.UpperBound(key);
+  }
+
+  pair<const_iterator, const_iterator> equal_range(const key_type& key) const {
+    return ft::make_pair(lower_bound(key), upper_bound(key));
+  }
+
+  pair<iterator, iterator> equal_range(const key_type& key) {
+    return ft::make_pair(lower_bound(key), upper_bound(key));
+  }
+
+  // heterogeneous lookup (ft only) : with a transparent Compare (e.g.
+  // ft::less<>), a key of any type Compare accepts is used as it is
+  template <typename K>
+  typename IfTransparent_<K, iterator>::type find(const K& k) {
+    return tree_.Search(k);
+  }
+
+  template <typename K>
+  typename IfTransparent_<K, const_iterator>::type find(const K& k) const {
+    return tree_.Search(k);
+  }
+
+  template <typename K>
+  typename IfTransparent_<K, size_type>::type count(const K& k) const {
+    return tree_.Search(k) == end() ? 0 : 1;
+  }
+
+  template <typename K>
+  typename IfTransparent_<K, iterator>::type lower_bound(const K& key) {
+    return tree_.LowerBound(key);
+  }
+
+  template <typename K>
+  typename IfTransparent_<K, const_iterator>::type lower_bound(
+      const K& key) const {
+    return tree_.LowerBound(key);
+  }
+
+  template <typename K>
+  typename IfTransparent_<K, iterator>::type upper_bound(const K& key) {
+    return tree_.UpperBound(key);
+  }
+
+  template <typename K>
+  typename IfTransparent_<K, const_iterator>::type upper_bound(
+      const K& key) const {
+    return tree_.UpperBound(key);
+  }
+
+  template <typename K>
+  typename IfTransparent_<K, pair<iterator, iterator> >::type equal_range(
+      const K& key) {
+    return ft::make_pair(tree_.LowerBound(key), tree_.UpperBound(key));
+  }
+
+  template <typename K>
+  typename IfTransparent_<K, pair<const_iterator, const_iterator> >::type
+  equal_range(const K& key) const {
+    return ft::make_pair(const_iterator(tree_.LowerBound(key)),
+                         const_iterator(tree_.UpperBound(key)));
+  }
+
+  // Allocator
+  allocator_type get_allocator(void) const FT_NOEXCEPT_ { return alloc_; }
+};
+
+template <typename Key, typename T, typename Compare, typename Alloc>
+bool operator==(const btree_map<Key, T, Compare, Alloc>& lhs,
+                const btree_map<Key, T, Compare, Alloc>& rhs) {
+  return (lhs.size() == rhs.size() &&
+          ft::equal(lhs.begin(), lhs.end(), rhs.begin()));
+}
+
+template <typename Key, typename T, typename Compare, typename Alloc>
+bool operator!=(const btree_map<Key, T, Compare, Alloc>& lhs,
+                const btree_map<Key, T, Compare, Alloc>& rhs) {
+  return !(lhs == rhs);
+}
+
+template <typename Key, typename T, typename Compare, typename Alloc>
+bool operator<(const btree_map<Key, T, Compare, Alloc>& lhs,
+               const btree_map<Key, T, Compare, Alloc>& rhs) {
+  return ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(),
+                                     rhs.end());
+}
+
+template <typename Key, typename T, typename Compare, typename Alloc>
+bool operator<=(const btree_map<Key, T, Compare, Alloc>& lhs,
+                const btree_map<Key, T, Compare, Alloc>& rhs) {
+  return !(rhs < lhs);
+}
+
+template <typename Key, typename T, typename Compare, typename Alloc>
+bool operator>(const btree_map<Key, T, Compare, Alloc>& lhs,
+               const btree_map<Key, T, Compare, Alloc>& rhs) {
+  return rhs < lhs;
+}
+
+template <typename Key, typename T, typename Compare, typename Alloc>
+bool operator>=(const btree_map<Key, T, Compare, Alloc>& lhs,
+                const btree_map<Key, T, Compare, Alloc>& rhs) {
+  return !(lhs < rhs);
+}
+
+template <typename Key, typename T, typename Compare, typename Alloc>
+void swap(btree_map<Key, T, Compare, Alloc>& x,
+          btree_map<Key, T, Compare, Alloc>& y) {
+  x.swap(y);
+}
+}  // namespace ft
+
+#endif
@@ -0,0 +1,279 @@
+/**
+ * @file btree_set.hpp
+ * @author ghan (ghan@student.42seoul.kr)
+ * @brief A header file for btree_set container
+ * @date 2022-07-25
+ */
+
+#ifndef FT_CONTAINERS_INCLUDES_BTREE_SET_HPP_
+#define FT_CONTAINERS_INCLUDES_BTREE_SET_HPP_
+
+#define FT_NOEXCEPT_ throw()
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+
+#include "algorithm.hpp"
+#include "btree.hpp"
+#include "iterator_traits.hpp"
+#include "rbtree.hpp"
+#include "utility.hpp"
+
+namespace ft {
+// btree_set is set over a B+ tree (see BTree) : faster lookups & scans,
+// but insert & erase invalidate the iterators to the elements they move
+template <typename Key, typename Compare = std::less<Key>,
+          typename Alloc = std::allocator<Key> >
+class btree_set {
+ public:
+  typedef Key key_type;
+  typedef Key value_type;
+  typedef Compare key_compare;
+  typedef Compare value_compare;
+  typedef Alloc allocator_type;
+  typedef typename allocator_type::reference reference;
+  typedef typename allocator_type::const_reference const_reference;
+  typedef typename allocator_type::pointer pointer;
+  typedef typename allocator_type::const_pointer const_pointer;
+
+ private:
+  typedef BTree<value_type, RbTreeIdentity<value_type>, key_compare,
+                allocator_type>
+      Base_;
+
+  // the return type R of a lookup by a key of type K, if Compare is
+  // transparent (depends on K, so that it is a substitution failure)
+  template <typename K, typename R>
+  struct IfTransparent_
+      : public enable_if<has_is_transparent<Compare>::value, R> {};
+
+  key_compare comp_;
+  allocator_type alloc_;
+  Base_ tree_;
+
+ public:
+  typedef typename Base_::const_iterator iterator;
+  typedef typename Base_::const_iterator const_iterator;
+  typedef typename Base_::const_reverse_iterator const_reverse_iterator;
+  typedef typename Base_::const_reverse_iterator reverse_iterator;
+  typedef typename iterator_traits<iterator>::difference_type difference_type;
+  typedef size_t size_type;
+
+  // Constructors
+  // #1 empty : empty container with no element
+  explicit btree_set(const key_compare& comp = key_compare(),
+                     const allocator_type& alloc = allocator_type())
+      : comp_(comp), alloc_(alloc), tree_(comp_, alloc_) {}
+
+  // #2 range : constructs with as many elements as the range [first, last)
+  template <typename InputIterator>
+  btree_set(InputIterator first,
+            typename enable_if<is_input_iterator<InputIterator>::value,
+                               InputIterator>::type last,
+            const key_compare& comp = key_compare(),
+            const allocator_type& alloc = allocator_type())
+      : comp_(comp), alloc_(alloc), tree_(comp_, alloc_) {
+    tree_.InsertRange(first, last);
+  }
+
+  // #2' sorted range (ft only) : [first, last) is sorted & unique, each
+  // element is appended in O(1) amortized
+  template <typename InputIterator>
+  btree_set(sorted_unique_t, InputIterator first,
+            typename enable_if<is_input_iterator<InputIterator>::value,
+                               InputIterator>::type last,
+            const key_compare& comp = key_compare(),
+            const allocator_type& alloc = allocator_type())
+      : comp_(comp), alloc_(alloc), tree_(comp_, alloc_) {
+    tree_.InsertSortedUnique(first, last);
+  }
+
+  // #3 copy constructor
+  btree_set(const btree_set& original)
+      : comp_(original.comp_),
+        alloc_(original.alloc_),
+        tree_(original.tree_) {}
+
+  // Destructor
+  ~btree_set(void) FT_NOEXCEPT_ {}
+
+  // Assignment operator overload (Deep copy)
+  btree_set& operator=(const btree_set& rhs) {
+    comp_ = rhs.comp_;
+    alloc_ = rhs.alloc_;
+    tree_ = rhs.tree_;
+    return *this;
+  }
+
+  // Iterators
+  iterator begin(void) const FT_NOEXCEPT_ { return tree_.begin(); }
+
+  iterator end(void) const FT_NOEXCEPT_ { return tree_.end(); }
+
+  reverse_iterator rbegin(void) const FT_NOEXCEPT_ { return tree_.rbegin(); }
+
+  reverse_iterator rend(void) const FT_NOEXCEPT_ { return tree_.rend(); }
+
+  // Capacity
+  bool empty(void) const FT_NOEXCEPT_ { return (tree_.GetSize() == 0); }
+
+  size_type size(void) const FT_NOEXCEPT_ { return tree_.GetSize(); }
+
+  size_type max_size(void) const FT_NOEXCEPT_ { return tree_.MaxSize(); }
+
+  // Modifiers
+  // single element
+  pair<iterator, bool> insert(const value_type& val) {
+    return tree_.Insert(val);
+  }
+
+  // single element at a given position
+  // O(1) when val goes right before or after position, in a leaf with room
+  iterator insert(iterator position, const value_type& val) {
+    return tree_.Insert(val, position).first;
+  }
+
+  // range
+  template <typename InputIterator>
+  void insert(InputIterator first,
+              typename enable_if<is_input_iterator<InputIterator>::value,
+                                 InputIterator>::type last) {
+    tree_.InsertRange(first, last);
+  }
+
+  // sorted range : [first, last) is sorted & unique (ft only)
+  template <typename InputIterator>
+  void insert(sorted_unique_t, InputIterator first,
+              typename enable_if<is_input_iterator<InputIterator>::value,
+                                 InputIterator>::type last) {
+    tree_.InsertSortedUnique(first, last);
+  }
+
+  // single element at a given position
+  void erase(iterator position) { tree_.Delete(position); }
+
+  // single element with a given key
+  size_type erase(const value_type& val) {
+    iterator position = find(val);
+    if (position == end()) return 0;
+    erase(position);
+    return 1;
+  }
+
+  // range
+  void erase(iterator first, iterator last) {
+    tree_.DeleteRange(first, last);
+  }
+
+  // the comparator & allocator go with the elements
+  void swap(btree_set& x) {
+    tree_.Swap(x.tree_);
+    std::swap(comp_, x.comp_);
+    std::swap(alloc_, x.alloc_);
+  }
+
+  void clear(void) FT_NOEXCEPT_ { tree_.Clear(); }
+
+  // Observers
+  key_compare key_comp(void) const { return comp_; }
+
+  value_compare value_comp(void) const { return comp_; }
+
+  // Operations
+  iterator find(const value_type& val) const { return tree_.Search(val); }
+
+  size_type count(const value_type& val) const {
+    return iterator(tree_.Search(val)) == tree_.end() ? 0 : 1;
+  }
+
+  iterator lower_bound(const value_type& val) const {
+    return tree_.LowerBound(val);
+  }
+
+  iterator upper_bound(const value_type& val) const {
+    return tree_.UpperBound(val);
+  }
+
+  pair<iterator, iterator> equal_range(const value_type& val) const {
+    return ft::make_pair(lower_bound(val), upper_bound(val));
+  }
+
+  // heterogeneous lookup (ft only) : with a transparent Compare (e.g.
+  // ft::less<>), a key of any type Compare accepts is used as it is
+  template <typename K>
+  typename IfTransparent_<K, iterator>::type find(const K& k) const {
+    return tree_.Search(k);
+  }
+
+  template <typename K>
+  typename IfTransparent_<K, size_type>::type count(const K& k) const {
+    return iterator(tree_.Search(k)) == tree_.end() ? 0 : 1;
+  }
+
+  template <typename K>
+  typename IfTransparent_<K, iterator>::type lower_bound(const K& key) const {
+    return tree_.LowerBound(key);
+  }
+
+  template <typename K>
+  typename IfTransparent_<K, iterator>::type upper_bound(const K& key) const {
+    return tree_.UpperBound(key);
+  }
+
+  template <typename K>
+  typename IfTransparent_<K, pair<iterator, iterator> >::type equal_range(
+      const K& key) const {
+    return ft::make_pair(lower_bound(key), upper_bound(key));
+  }
+
+  // Allocator
+  allocator_type get_allocator(void) const FT_NOEXCEPT_ { return alloc_; }
+};
+
+template <typename Key, typename Compare, typename Alloc>
+bool operator==(const btree_set<Key, Compare, Alloc>& lhs,
+                const btree_set<Key, Compare, Alloc>& rhs) {
+  return (lhs.size() == rhs.size() &&
+          ft::equal(lhs.begin(), lhs.end(), rhs.begin()));
+}
+
+template <typename Key, typename Compare, typename Alloc>
+bool operator!=(const btree_set<Key, Compare, Alloc>& lhs,
+                const btree_set<Key, Compare, Alloc>& rhs) {
+  return !(lhs == rhs);
+}
+
+template <typename Key, typename Compare, typename Alloc>
+bool operator<(const btree_set<Key, Compare, Alloc>& lhs,
+               const btree_set<Key, Compare, Alloc>& rhs) {
+  return ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(),
+                                     rhs.end());
+}
+
+template <typename Key, typename Compare, typename Alloc>
+bool operator<=(const btree_set<Key, Compare, Alloc>& lhs,
+                const btree_set<Key, Compare, Alloc>& rhs) {
+  return !(rhs < lhs);
+}
+
+template <typename Key, typename Compare, typename Alloc>
+bool operator>(const btree_set<Key, Compare, Alloc>& lhs,
+               const btree_set<Key, Compare, Alloc>& rhs) {
+  return rhs < lhs;
+}
+
+template <typename Key, typename Compare, typename Alloc>
+bool operator>=(const btree_set<Key, Compare, Alloc>& lhs,
+                const btree_set<Key, Compare, Alloc>& rhs) {
+  return !(lhs < rhs);
+}
+
+template <typename Key, typename Compare, typename Alloc>
+void swap(btree_set<Key, Compare, Alloc>& x,
+          btree_set<Key, Compare, Alloc>& y) {
+  x.swap(y);
+}
+}  // namespace ft
+
+#endif
@@ -0,0 +1,339 @@
+/**
+ * @file concurrent_map.hpp
+ * @author ghan (ghan@student.42seoul.kr)
+ * @brief A header file for concurrent_map, a map sharded over rw-locked maps
+ * @date 2022-08-01
+ */
+
+#ifndef FT_CONTAINERS_INCLUDES_CONCURRENT_MAP_HPP_
+#define FT_CONTAINERS_INCLUDES_CONCURRENT_MAP_HPP_
+
+#define FT_NOEXCEPT_ throw()
+
+#include <pthread.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <new>
+#include <string>
+
+#include "map.hpp"
+#include "type_traits.hpp"
+#include "utility.hpp"
+#include "vector.hpp"
+
+namespace ft {
+
+// SECTION : shard hash
+// Picks the shard of a key. Integral keys are mixed (the finalizer of
+// MurmurHash3, after folding the upper half), so that consecutive keys
+// spread over the shards; strings are hashed with FNV-1a. Other key types
+// need a Hash of their own.
+template <typename Key, bool Integral = is_integral<Key>::value>
+struct shard_hash;
+
+template <typename Key>
+struct shard_hash<Key, true> {
+  size_t operator()(Key key) const FT_NOEXCEPT_ {
+    size_t h = static_cast<size_t>(key);
+    h ^= h >> 16 >> 16;
+    h ^= h >> 16;
+    h *= static_cast<size_t>(0x85ebca6bUL);
+    h ^= h >> 13;
+    h *= static_cast<size_t>(0xc2b2ae35UL);
+    h ^= h >> 16;
+    return h;
+  }
+};
+
+template <>
+struct shard_hash<std::string, false> {
+  size_t operator()(const std::string& key) const FT_NOEXCEPT_ {
+    size_t h = static_cast<size_t>(2166136261UL);
+    for (std::string::size_type i = 0; i < key.size(); ++i) {
+      h ^= static_cast<unsigned char>(key[i]);
+      h *= static_cast<size_t>(16777619UL);
+    }
+    return h;
+  }
+};
+
+// concurrent_map splits its keys over N shards by Hash, each an ft::map (a
+// red-black tree) behind its own pthread reader-writer lock : lookups of any
+// shard run in parallel, and writers only block the shard of their key.
+// Iterators could not outlive the locks, so elements are handed out as
+// copies, or to a function called under the locks (for_each,
+// for_each_in_range) which walks all shards in key order with a k-way merge.
+template <typename Key, typename T, typename Compare = std::less<Key>,
+          typename Hash = shard_hash<Key>,
+          typename Alloc = std::allocator<pair<const Key, T> > >
+class concurrent_map {
+ public:
+  typedef Key key_type;
+  typedef T mapped_type;
+  typedef pair<const key_type, mapped_type> value_type;
+  typedef Compare key_compare;
+  typedef Hash hasher;
+  typedef Alloc allocator_type;
+  typedef size_t size_type;
+
+ private:
+  typedef map<key_type, mapped_type, key_compare, allocator_type> Map_;
+  typedef typename Map_::const_iterator MapIterator_;
+
+  // the padding keeps the locks of neighbour shards off one cache line
+  struct Shard_ {
+    mutable pthread_rwlock_t lock;
+    Map_ elems;
+    char padding[64];
+
+    Shard_(const key_compare& comp, const allocator_type& alloc)
+        : elems(comp, alloc) {
+      pthread_rwlock_init(&lock, NULL);
+    }
+
+    ~Shard_(void) { pthread_rwlock_destroy(&lock); }
+  };
+
+  // SECTION : lock guards
+  // released on scope exit, a throwing copy or function included
+  class ReadGuard_ {
+   public:
+    explicit ReadGuard_(const Shard_& shard) : lock_(&shard.lock) {
+      pthread_rwlock_rdlock(lock_);
+    }
+
+    ~ReadGuard_(void) { pthread_rwlock_unlock(lock_); }
+
+   private:
+    pthread_rwlock_t* lock_;
+
+    ReadGuard_(const ReadGuard_&);
+    ReadGuard_& operator=(const ReadGuard_&);
+  };
+
+  class WriteGuard_ {
+   public:
+    explicit WriteGuard_(Shard_& shard) : lock_(&shard.lock) {
+      pthread_rwlock_wrlock(lock_);
+    }
+
+    ~WriteGuard_(void) { pthread_rwlock_unlock(lock_); }
+
+   private:
+    pthread_rwlock_t* lock_;
+
+    WriteGuard_(const WriteGuard_&);
+    WriteGuard_& operator=(const WriteGuard_&);
+  };
+
+  // every shard, taken in index order : writers hold one lock at a time, so
+  // this cannot deadlock
+  class ReadAllGuard_ {
+   public:
+    ReadAllGuard_(Shard_* shards, size_type n_shards)
+        : shards_(shards), n_shards_(n_shards) {
+      for (size_type i = 0; i < n_shards_; ++i)
+        pthread_rwlock_rdlock(&shards_[i].lock);
+    }
+
+    ~ReadAllGuard_(void) {
+      for (size_type i = n_shards_; i > 0; --i)
+        pthread_rwlock_unlock(&shards_[i - 1].lock);
+    }
+
+   private:
+    Shard_* shards_;
+    size_type n_shards_;
+
+    ReadAllGuard_(const ReadAllGuard_&);
+    ReadAllGuard_& operator=(const ReadAllGuard_&);
+  };
+
+  // SECTION : k-way merge
+  // the next element of one shard, and the end of its range
+  struct Cursor_ {
+    MapIterator_ it;
+    MapIterator_ last;
+  };
+
+  // heap order : the cursor with the least key on top
+  class CursorGreater_ {
+   public:
+    explicit CursorGreater_(const key_compare& comp) : comp_(comp) {}
+
+    bool operator()(const Cursor_& x, const Cursor_& y) const {
+      return comp_(y.it->first, x.it->first);
+    }
+
+   private:
+    key_compare comp_;
+  };
+
+  Shard_* shards_;
+  size_type n_shards_;
+  key_compare comp_;
+  hasher hash_;
+
+  Shard_& ShardOf_(const key_type& key) const {
+    return shards_[hash_(key) % n_shards_];
+  }
+
+  // the non-empty ranges are popped in key order from a heap of cursors :
+  // O(m log N) for m elements over N shards. The caller holds the locks.
+  template <typename Function>
+  void Merge_(vector<Cursor_>& cursors, Function& f) const {
+    Cursor_* heap = cursors.begin().base();
+    size_type n = cursors.size();
+    const CursorGreater_ greater(comp_);
+    std::make_heap(heap, heap + n, greater);
+    while (n > 0) {
+      std::pop_heap(heap, heap + n, greater);
+      Cursor_& top = heap[n - 1];
+      f(*top.it);
+      if (++top.it == top.last)
+        --n;
+      else
+        std::push_heap(heap, heap + n, greater);
+    }
+  }
+
+  concurrent_map(const concurrent_map&);
+  concurrent_map& operator=(const concurrent_map&);
+
+ public:
+  // Constructors
+  // n_shards maps (at least 1), each with a copy of comp & alloc
+  explicit concurrent_map(size_type n_shards = 16,
+                          const key_compare& comp = key_compare(),
+                          const hasher& hash = hasher(),
+                          const allocator_type& alloc = allocator_type())
+      : shards_(NULL),
+        n_shards_(n_shards == 0 ? 1 : n_shards),
+        comp_(comp),
+        hash_(hash) {
+    shards_ =
+        static_cast<Shard_*>(::operator new(n_shards_ * sizeof(Shard_)));
+    size_type i = 0;
+    try {
+      for (; i < n_shards_; ++i) new (shards_ + i) Shard_(comp, alloc);
+    } catch (...) {
+      while (i > 0) shards_[--i].~Shard_();
+      ::operator delete(shards_);
+      throw;
+    }
+  }
+
+  // Destructor : no other thread may use the map by then
+  ~concurrent_map(void) FT_NOEXCEPT_ {
+    for (size_type i = 0; i < n_shards_; ++i) shards_[i].~Shard_();
+    ::operator delete(shards_);
+  }
+
+  // Capacity
+  // a sum over the shards, taken one after the other : exact only when no
+  // other thread writes meanwhile
+  size_type size(void) const {
+    size_type n = 0;
+    for (size_type i = 0; i < n_shards_; ++i) {
+      ReadGuard_ guard(shards_[i]);
+      n += shards_[i].elems.size();
+    }
+    return n;
+  }
+
+  bool empty(void) const { return size() == 0; }
+
+  size_type shard_count(void) const FT_NOEXCEPT_ { return n_shards_; }
+
+  // Modifiers
+  // false, and nothing changed, if key was already there
+  bool insert(const value_type& val) {
+    Shard_& shard = ShardOf_(val.first);
+    WriteGuard_ guard(shard);
+    return shard.elems.insert(val).second;
+  }
+
+  // true if key was new, false if its mapped value was assigned obj
+  template <typename M>
+  bool insert_or_assign(const key_type& key, const M& obj) {
+    Shard_& shard = ShardOf_(key);
+    WriteGuard_ guard(shard);
+    return shard.elems.insert_or_assign(key, obj).second;
+  }
+
+  size_type erase(const key_type& key) {
+    Shard_& shard = ShardOf_(key);
+    WriteGuard_ guard(shard);
+    return shard.elems.erase(key);
+  }
+
+  void clear(void) {
+    for (size_type i = 0; i < n_shards_; ++i) {
+      WriteGuard_ guard(shards_[i]);
+      shards_[i].elems.clear();
+    }
+  }
+
+  // Observers
+  key_compare key_comp(void) const { return comp_; }
+
+  hasher hash_function(void) const { return hash_; }
+
+  // Operations
+  // the mapped value of key is copied to out, if key is there
+  bool find(const key_type& key, mapped_type& out) const {
+    const Shard_& shard = ShardOf_(key);
+    ReadGuard_ guard(shard);
+    MapIterator_ it = shard.elems.find(key);
+    if (it == shard.elems.end()) return false;
+    out = it->second;
+    return true;
+  }
+
+  size_type count(const key_type& key) const {
+    const Shard_& shard = ShardOf_(key);
+    ReadGuard_ guard(shard);
+    return shard.elems.count(key);
+  }
+
+  // f(value) for every element, in key order, with all the shards read
+  // locked : f sees one snapshot, and must not call into this map
+  template <typename Function>
+  Function for_each(Function f) const {
+    ReadAllGuard_ guard(shards_, n_shards_);
+    vector<Cursor_> cursors;
+    cursors.reserve(n_shards_);
+    for (size_type i = 0; i < n_shards_; ++i) {
+      const Map_& elems = shards_[i].elems;
+      if (elems.empty()) continue;
+      const Cursor_ cursor = {elems.begin(), elems.end()};
+      cursors.push_back(cursor);
+    }
+    Merge_(cursors, f);
+    return f;
+  }
+
+  // same as for_each, for the keys in [first, last)
+  template <typename Function>
+  Function for_each_in_range(const key_type& first, const key_type& last,
+                             Function f) const {
+    if (!comp_(first, last)) return f;
+    ReadAllGuard_ guard(shards_, n_shards_);
+    vector<Cursor_> cursors;
+    cursors.reserve(n_shards_);
+    for (size_type i = 0; i < n_shards_; ++i) {
+      const Map_& elems = shards_[i].elems;
+      const Cursor_ cursor = {elems.lower_bound(first),
+                              elems.lower_bound(last)};
+      if (cursor.it != cursor.last) cursors.push_back(cursor);
+    }
+    Merge_(cursors, f);
+    return f;
+  }
+};
+}  // namespace ft
+
+#endif
@@ -0,0 +1,827 @@
+/**
+ * @file deque.hpp
+ * @author ghan (ghan@student.42seoul.kr)
+ * @brief A header file for deque container
+ * @date 2022-07-11
+ */
+
+#ifndef FT_CONTAINERS_INCLUDES_DEQUE_HPP_
+#define FT_CONTAINERS_INCLUDES_DEQUE_HPP_
+
+#define FT_NOEXCEPT_ throw()
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <memory>
+
+#include "algorithm.hpp"
+#include "iterator_traits.hpp"
+#include "type_traits.hpp"
+
+namespace ft {
+
+// SECTION : block size
+// elements are stored in fixed-size blocks of 4096 bytes, or of 16 elements
+// for the large ones
+template <typename T>
+struct DequeBlockSize {
+  static const size_t value = (sizeof(T) < 256) ? 4096 / sizeof(T) : 16;
+};
+
+template <typename T, typename Alloc>
+class DequeBase;
+
+template <typename T, typename Alloc>
+class deque;
+
+// SECTION : deque iterator class
+// implementation of random access iterator for ft::deque. Besides the element
+// it points to, the iterator knows its block ([first_, last_)) and the slot
+// of the block in the map (node_), so that it can step over to the next one.
+template <typename T, typename Ref, typename Ptr>
+class DequeIterator {
+ private:
+  template <typename, typename>
+  friend class DequeBase;
+
+  template <typename, typename>
+  friend class deque;
+
+  template <typename, typename, typename>
+  friend class DequeIterator;
+
+  typedef T** MapPointer_;
+
+  T* cur_;
+  T* first_;
+  T* last_;
+  MapPointer_ node_;
+
+  static ptrdiff_t BlockSize_(void) { return DequeBlockSize<T>::value; }
+
+  // moves to another block, cur_ is left to the caller
+  void SetNode_(MapPointer_ node) {
+    node_ = node;
+    first_ = *node;
+    last_ = first_ + BlockSize_();
+  }
+
+ public:
+  typedef random_access_iterator_tag iterator_category;
+  typedef T value_type;
+  typedef ptrdiff_t difference_type;
+  typedef Ptr pointer;
+  typedef Ref reference;
+
+  // Constructors
+  DequeIterator(void) : cur_(NULL), first_(NULL), last_(NULL), node_(NULL) {}
+
+  DequeIterator(T* cur, MapPointer_ node)
+      : cur_(cur), first_(*node), last_(*node + BlockSize_()), node_(node) {}
+
+  // copy
+  DequeIterator(const DequeIterator& original)
+      : cur_(original.cur_),
+        first_(original.first_),
+        last_(original.last_),
+        node_(original.node_) {}
+
+  // const conversion : from the mutable iterator only
+  template <typename RefR, typename PtrR>
+  DequeIterator(
+      const DequeIterator<T, RefR, PtrR>& original,
+      typename enable_if<is_same<PtrR, T*>::value>::type* = NULL)
+      : cur_(original.cur_),
+        first_(original.first_),
+        last_(original.last_),
+        node_(original.node_) {}
+
+  // Destructor
+  ~DequeIterator(void) {}
+
+  // Copy Assignment operator overload
+  DequeIterator& operator=(const DequeIterator& rhs) {
+    cur_ = rhs.cur_;
+    first_ = rhs.first_;
+    last_ = rhs.last_;
+    node_ = rhs.node_;
+    return *this;
+  }
+
+  // dereference & reference
+  reference operator*(void) const { return *cur_; }
+
+  pointer operator->(void) const { return cur_; }
+
+  // increment & decrement
+  DequeIterator& operator++(void) {
+    ++cur_;
+    if (cur_ == last_) {
+      SetNode_(node_ + 1);
+      cur_ = first_;
+    }
+    return *this;
+  }
+
+  DequeIterator operator++(int) {
+    DequeIterator tmp = *this;
+    ++*this;
+    return tmp;
+  }
+
+  DequeIterator& operator--(void) {
+    if (cur_ == first_) {
+      SetNode_(node_ - 1);
+      cur_ = last_;
+    }
+    --cur_;
+    return *this;
+  }
+
+  DequeIterator operator--(int) {
+    DequeIterator tmp = *this;
+    --*this;
+    return tmp;
+  }
+
+  // add or subtract difference
+  DequeIterator& operator+=(difference_type n) {
+    const difference_type offset = n + (cur_ - first_);
+    if (offset >= 0 && offset < BlockSize_())
+      cur_ += n;
+    else {
+      const difference_type node_offset =
+          (offset > 0) ? offset / BlockSize_()
+                       : -((-offset - 1) / BlockSize_()) - 1;
+      SetNode_(node_ + node_offset);
+      cur_ = first_ + (offset - node_offset * BlockSize_());
+    }
+    return *this;
+  }
+
+  DequeIterator& operator-=(difference_type n) { return *this += -n; }
+
+  DequeIterator operator+(difference_type n) const {
+    DequeIterator tmp = *this;
+    return tmp += n;
+  }
+
+  DequeIterator operator-(difference_type n) const {
+    DequeIterator tmp = *this;
+    return tmp -= n;
+  }
+
+  // subscript
+  reference operator[](difference_type n) const { return *(*this + n); }
+
+  template <typename U, typename RefL, typename PtrL, typename RefR,
+            typename PtrR>
+  friend bool operator==(const DequeIterator<U, RefL, PtrL>& lhs,
+                         const DequeIterator<U, RefR, PtrR>& rhs);
+
+  template <typename U, typename RefL, typename PtrL, typename RefR,
+            typename PtrR>
+  friend bool operator<(const DequeIterator<U, RefL, PtrL>& lhs,
+                        const DequeIterator<U, RefR, PtrR>& rhs);
+
+  template <typename U, typename RefL, typename PtrL, typename RefR,
+            typename PtrR>
+  friend ptrdiff_t operator-(const DequeIterator<U, RefL, PtrL>& lhs,
+                             const DequeIterator<U, RefR, PtrR>& rhs);
+};
+
+template <typename T, typename RefL, typename PtrL, typename RefR,
+          typename PtrR>
+inline bool operator==(const DequeIterator<T, RefL, PtrL>& lhs,
+                       const DequeIterator<T, RefR, PtrR>& rhs) {
+  return lhs.cur_ == rhs.cur_;
+}
+
+template <typename T, typename RefL, typename PtrL, typename RefR,
+          typename PtrR>
+inline bool operator!=(const DequeIterator<T, RefL, PtrL>& lhs,
+                       const DequeIterator<T, RefR, PtrR>& rhs) {
+  return !(lhs == rhs);
+}
+
+template <typename T, typename RefL, typename PtrL, typename RefR,
+          typename PtrR>
+inline bool operator<(const DequeIterator<T, RefL, PtrL>& lhs,
+                      const DequeIterator<T, RefR, PtrR>& rhs) {
+  return (lhs.node_ == rhs.node_) ? lhs.cur_ < rhs.cur_ : lhs.node_ < rhs.node_;
+}
+
+template <typename T, typename RefL, typename PtrL, typename RefR,
+          typename PtrR>
+inline bool operator>(const DequeIterator<T, RefL, PtrL>& lhs,
+                      const DequeIterator<T, RefR, PtrR>& rhs) {
+  return rhs < lhs;
+}
+
+template <typename T, typename RefL, typename PtrL, typename RefR,
+          typename PtrR>
+inline bool operator<=(const DequeIterator<T, RefL, PtrL>& lhs,
+                       const DequeIterator<T, RefR, PtrR>& rhs) {
+  return !(rhs < lhs);
+}
+
+template <typename T, typename RefL, typename PtrL, typename RefR,
+          typename PtrR>
+inline bool operator>=(const DequeIterator<T, RefL, PtrL>& lhs,
+                       const DequeIterator<T, RefR, PtrR>& rhs) {
+  return !(lhs < rhs);
+}
+
+template <typename T, typename RefL, typename PtrL, typename RefR,
+          typename PtrR>
+inline ptrdiff_t operator-(const DequeIterator<T, RefL, PtrL>& lhs,
+                           const DequeIterator<T, RefR, PtrR>& rhs) {
+  if (lhs.node_ == rhs.node_) return lhs.cur_ - rhs.cur_;
+  return DequeIterator<T, RefL, PtrL>::BlockSize_() *
+             (lhs.node_ - rhs.node_ - 1) +
+         (lhs.cur_ - lhs.first_) + (rhs.last_ - rhs.cur_);
+}
+
+template <typename T, typename Ref, typename Ptr>
+inline DequeIterator<T, Ref, Ptr> operator+(
+    ptrdiff_t n, const DequeIterator<T, Ref, Ptr>& itr) {
+  return itr + n;
+}
+
+// SECTION : deque base class (RAII wrapper)
+// owns the map (an array of block pointers) and the blocks in
+// [start_.node_, finish_.node_], not the elements. finish_ always points to a
+// free slot, so the block of finish_ exists even when it holds no element.
+// An empty deque may have no map at all (map_ == NULL, start_ & finish_ null
+// iterators) : it is allocated on the first push or insert.
+template <typename T, typename Alloc = std::allocator<T> >
+class DequeBase {
+ protected:
+  // member types
+  typedef T value_type;
+  typedef Alloc allocator_type;
+  typedef typename allocator_type::pointer pointer;
+  typedef typename allocator_type::size_type size_type;
+  typedef typename allocator_type::template rebind<pointer>::other
+      MapAllocator_;
+  typedef pointer* MapPointer_;
+  typedef DequeIterator<T, T&, T*> iterator;
+
+  MapPointer_ map_;        // block pointers
+  size_type map_size_;     // number of slots in map_
+  iterator start_;         // first element
+  iterator finish_;        // one past the last element
+  allocator_type alloc_;   // allocator
+  MapAllocator_ map_alloc_;
+
+  static size_type BlockSize_(void) { return DequeBlockSize<T>::value; }
+
+  pointer AllocateNode_(void) { return alloc_.allocate(BlockSize_()); }
+
+  void DeallocateNode_(pointer block) {
+    alloc_.deallocate(block, BlockSize_());
+  }
+
+  MapPointer_ AllocateMap_(size_type n) { return map_alloc_.allocate(n); }
+
+  void DeallocateMap_(MapPointer_ map, size_type n) {
+    map_alloc_.deallocate(map, n);
+  }
+
+  void CreateNodes_(MapPointer_ nstart, MapPointer_ nfinish) {
+    MapPointer_ cur = nstart;
+    try {
+      for (; cur < nfinish; ++cur) *cur = AllocateNode_();
+    } catch (...) {
+      DestroyNodes_(nstart, cur);
+      throw;
+    }
+  }
+
+  void DestroyNodes_(MapPointer_ nstart, MapPointer_ nfinish) {
+    for (MapPointer_ cur = nstart; cur < nfinish; ++cur) DeallocateNode_(*cur);
+  }
+
+  // room for n elements, centered in the map so that both ends can grow
+  void InitializeMap_(size_type n) {
+    const size_type num_nodes = n / BlockSize_() + 1;
+    map_size_ = std::max(static_cast<size_type>(8), num_nodes + 2);
+    map_ = AllocateMap_(map_size_);
+    MapPointer_ nstart = map_ + (map_size_ - num_nodes) / 2;
+    MapPointer_ nfinish = nstart + num_nodes;
+    try {
+      CreateNodes_(nstart, nfinish);
+    } catch (...) {
+      DeallocateMap_(map_, map_size_);
+      throw;
+    }
+    start_.SetNode_(nstart);
+    start_.cur_ = start_.first_;
+    finish_.SetNode_(nfinish - 1);
+    finish_.cur_ = finish_.first_ + n % BlockSize_();
+  }
+
+  explicit DequeBase(const allocator_type& alloc = allocator_type())
+      : map_(NULL), map_size_(0), alloc_(alloc), map_alloc_(alloc) {}
+
+  DequeBase(size_type n, const allocator_type& alloc)
+      : map_(NULL), map_size_(0), alloc_(alloc), map_alloc_(alloc) {
+    if (n > 0) InitializeMap_(n);
+  }
+
+  ~DequeBase(void) {
+    if (map_ == NULL) return;
+    DestroyNodes_(start_.node_, finish_.node_ + 1);
+    DeallocateMap_(map_, map_size_);
+  }
+};
+
+template <typename T, typename Alloc = std::allocator<T> >
+class deque : protected DequeBase<T, Alloc> {
+ private:
+  typedef DequeBase<T, Alloc> Base_;
+  typedef typename Base_::MapPointer_ MapPointer_;
+
+ public:
+  // SECTION : member types
+  typedef T value_type;
+  typedef typename Base_::allocator_type allocator_type;
+  typedef typename allocator_type::size_type size_type;
+  typedef typename allocator_type::difference_type difference_type;
+  typedef typename allocator_type::pointer pointer;
+  typedef typename allocator_type::const_pointer const_pointer;
+  typedef value_type& reference;
+  typedef const value_type& const_reference;
+  typedef DequeIterator<T, T&, T*> iterator;
+  typedef DequeIterator<T, const T&, const T*> const_iterator;
+  typedef reverse_iterator<const_iterator> const_reverse_iterator;
+  typedef reverse_iterator<iterator> reverse_iterator;
+
+ private:
+  // SECTION : map management
+  // Growing only ever adds blocks and block pointers : the elements never
+  // move, so references to them stay valid across push_back / push_front.
+  void ReallocateMap_(size_type nodes_to_add, bool add_at_front) {
+    const size_type old_num_nodes =
+        this->finish_.node_ - this->start_.node_ + 1;
+    const size_type new_num_nodes = old_num_nodes + nodes_to_add;
+    MapPointer_ new_nstart;
+    if (this->map_size_ > 2 * new_num_nodes) {
+      // enough room, recenter the block pointers
+      new_nstart = this->map_ + (this->map_size_ - new_num_nodes) / 2 +
+                   (add_at_front ? nodes_to_add : 0);
+      if (new_nstart < this->start_.node_)
+        std::copy(this->start_.node_, this->finish_.node_ + 1, new_nstart);
+      else
+        std::copy_backward(this->start_.node_, this->finish_.node_ + 1,
+                           new_nstart + old_num_nodes);
+    } else {
+      const size_type new_map_size =
+          this->map_size_ + std::max(this->map_size_, nodes_to_add) + 2;
+      MapPointer_ new_map = this->AllocateMap_(new_map_size);
+      new_nstart = new_map + (new_map_size - new_num_nodes) / 2 +
+                   (add_at_front ? nodes_to_add : 0);
+      std::copy(this->start_.node_, this->finish_.node_ + 1, new_nstart);
+      this->DeallocateMap_(this->map_, this->map_size_);
+      this->map_ = new_map;
+      this->map_size_ = new_map_size;
+    }
+    this->start_.SetNode_(new_nstart);
+    this->finish_.SetNode_(new_nstart + old_num_nodes - 1);
+  }
+
+  void ReserveMapAtBack_(void) {
+    if (this->map_ + this->map_size_ - this->finish_.node_ < 2)
+      ReallocateMap_(1, false);
+  }
+
+  void ReserveMapAtFront_(void) {
+    if (this->start_.node_ == this->map_) ReallocateMap_(1, true);
+  }
+
+  // the last free slot of the back block is taken, start a new block
+  void PushBackAux_(const value_type& val) {
+    ReserveMapAtBack_();
+    *(this->finish_.node_ + 1) = this->AllocateNode_();
+    try {
+      this->alloc_.construct(this->finish_.cur_, val);
+    } catch (...) {
+      this->DeallocateNode_(*(this->finish_.node_ + 1));
+      throw;
+    }
+    this->finish_.SetNode_(this->finish_.node_ + 1);
+    this->finish_.cur_ = this->finish_.first_;
+  }
+
+  // the front block is full, start a new block
+  void PushFrontAux_(const value_type& val) {
+    ReserveMapAtFront_();
+    *(this->start_.node_ - 1) = this->AllocateNode_();
+    iterator new_start = this->start_;
+    new_start.SetNode_(this->start_.node_ - 1);
+    new_start.cur_ = new_start.last_ - 1;
+    try {
+      this->alloc_.construct(new_start.cur_, val);
+    } catch (...) {
+      this->DeallocateNode_(new_start.first_);
+      throw;
+    }
+    this->start_ = new_start;
+  }
+
+  // the back block is left empty, release it
+  void PopBackAux_(void) {
+    this->DeallocateNode_(this->finish_.first_);
+    this->finish_.SetNode_(this->finish_.node_ - 1);
+    this->finish_.cur_ = this->finish_.last_ - 1;
+    this->alloc_.destroy(this->finish_.cur_);
+  }
+
+  // the front block is left empty, release it
+  void PopFrontAux_(void) {
+    this->alloc_.destroy(this->start_.cur_);
+    this->DeallocateNode_(this->start_.first_);
+    this->start_.SetNode_(this->start_.node_ + 1);
+    this->start_.cur_ = this->start_.first_;
+  }
+
+  // SECTION : insertion & erasure utils
+  // n copies of val at one end, all or nothing
+  void PushBackN_(size_type n, const value_type& val) {
+    size_type pushed = 0;
+    try {
+      for (; pushed < n; ++pushed) push_back(val);
+    } catch (...) {
+      for (; pushed > 0; --pushed) pop_back();
+      throw;
+    }
+  }
+
+  void PushFrontN_(size_type n, const value_type& val) {
+    size_type pushed = 0;
+    try {
+      for (; pushed < n; ++pushed) push_front(val);
+    } catch (...) {
+      for (; pushed > 0; --pushed) pop_front();
+      throw;
+    }
+  }
+
+  void DestroyRange_(pointer first, pointer last) {
+    for (; first != last; ++first) this->alloc_.destroy(first);
+  }
+
+  // n slots are opened at the end closer to position, and the elements in
+  // between are shifted towards it. Only that side moves, so inserting near
+  // either end stays cheap. The pushed copies of val which are not shifted
+  // over are already in place.
+  void FillInsert_(size_type elems_before, size_type n,
+                   const value_type& val) {
+    if (n == 0) return;
+    const value_type val_copy(val);
+    const size_type length = size();
+    if (elems_before < length / 2) {
+      PushFrontN_(n, val_copy);
+      iterator old_start = this->start_ + n;
+      std::copy(old_start, old_start + elems_before, this->start_);
+      std::fill(this->start_ + std::max(elems_before, n),
+                old_start + elems_before, val_copy);
+    } else {
+      PushBackN_(n, val_copy);
+      iterator pos = this->start_ + elems_before;
+      std::copy_backward(pos, this->start_ + length, this->finish_);
+      std::fill(pos, pos + std::min(n, length - elems_before), val_copy);
+    }
+  }
+
+  template <typename InputIterator>
+  void RangeInsert_(
+      size_type elems_before, InputIterator first,
+      typename enable_if<!is_forward_iterator<InputIterator>::value,
+                         InputIterator>::type last) {
+    deque temp(first, last, this->alloc_);
+    RangeInsert_(elems_before, temp.begin(), temp.end());
+  }
+
+  template <typename ForwardIterator>
+  void RangeInsert_(
+      size_type elems_before, ForwardIterator first,
+      typename enable_if<is_forward_iterator<ForwardIterator>::value,
+                         ForwardIterator>::type last) {
+    const size_type n =
+        static_cast<size_type>(std::distance<ForwardIterator>(first, last));
+    if (n == 0) return;
+    const size_type length = size();
+    if (elems_before < length / 2) {
+      PushFrontN_(n, *first);
+      iterator old_start = this->start_ + n;
+      std::copy(old_start, old_start + elems_before, this->start_);
+      std::copy(first, last, this->start_ + elems_before);
+    } else {
+      PushBackN_(n, *first);
+      iterator pos = this->start_ + elems_before;
+      std::copy_backward(pos, this->start_ + length, this->finish_);
+      std::copy(first, last, pos);
+    }
+  }
+
+ public:
+  // SECTION : constructors & destructor
+  // #1 default : empty container constructor (no elem)
+  explicit deque(const allocator_type& alloc = allocator_type())
+      : Base_(alloc) {}
+
+  // #2 fill : construct a container with n elements, fill them with val
+  explicit deque(size_type n, const value_type& val = value_type(),
+                 const allocator_type& alloc = allocator_type())
+      : Base_(n, alloc) {
+    std::uninitialized_fill(this->start_, this->finish_, val);
+  }
+
+  // #3 range : construct a container with the values in [first, last)
+  template <typename InputIterator>
+  deque(InputIterator first,
+        typename enable_if<is_input_iterator<InputIterator>::value,
+                           InputIterator>::type last,
+        const allocator_type& alloc = allocator_type())
+      : Base_(alloc) {
+    try {
+      for (; first != last; ++first) push_back(*first);
+    } catch (...) {
+      clear();
+      throw;
+    }
+  }
+
+  // #4 copy constructor (keeps and uses a copy of x's alloc)
+  deque(const deque& x) : Base_(x.size(), x.alloc_) {
+    std::uninitialized_copy(x.begin(), x.end(), this->start_);
+  }
+
+  // destructor
+  ~deque(void) FT_NOEXCEPT_ { clear(); }
+
+  // SECTION : operator=
+  // preserves the current allocator, reuses the current elements
+  deque& operator=(const deque& x) {
+    if (this != &x) assign(x.begin(), x.end());
+    return *this;
+  }
+
+  // SECTION : iterators
+  iterator begin(void) FT_NOEXCEPT_ { return this->start_; }
+
+  const_iterator begin(void) const FT_NOEXCEPT_ { return this->start_; }
+
+  iterator end(void) FT_NOEXCEPT_ { return this->finish_; }
+
+  const_iterator end(void) const FT_NOEXCEPT_ { return this->finish_; }
+
+  reverse_iterator rbegin(void) FT_NOEXCEPT_ { return reverse_iterator(end()); }
+
+  const_reverse_iterator rbegin(void) const FT_NOEXCEPT_ {
+    return const_reverse_iterator(end());
+  }
+
+  reverse_iterator rend(void) FT_NOEXCEPT_ { return reverse_iterator(begin()); }
+
+  const_reverse_iterator rend(void) const FT_NOEXCEPT_ {
+    return const_reverse_iterator(begin());
+  }
+
+  // SECTION : capacity
+  size_type size(void) const FT_NOEXCEPT_ {
+    return size_type(this->finish_ - this->start_);
+  }
+
+  size_type max_size(void) const FT_NOEXCEPT_ {
+    return this->alloc_.max_size();
+  }
+
+  void resize(size_type n, value_type val = value_type()) {
+    const size_type length = size();
+    if (n < length)
+      erase(begin() + n, end());
+    else
+      FillInsert_(length, n - length, val);
+  }
+
+  bool empty(void) const FT_NOEXCEPT_ {
+    return this->finish_ == this->start_;
+  }
+
+  // SECTION : element access
+  reference operator[](size_type n) FT_NOEXCEPT_ {
+    return this->start_[difference_type(n)];
+  }
+
+  const_reference operator[](size_type n) const FT_NOEXCEPT_ {
+    return this->start_[difference_type(n)];
+  }
+
+  reference at(size_type n) {
+    if (n >= size()) throw std::out_of_range("exceeds the deque's size");
+    return (*this)[n];
+  }
+
+  const_reference at(size_type n) const {
+    if (n >= size()) throw std::out_of_range("exceeds the deque's size");
+    return (*this)[n];
+  }
+
+  reference front(void) FT_NOEXCEPT_ { return *this->start_; }
+
+  const_reference front(void) const FT_NOEXCEPT_ { return *this->start_; }
+
+  reference back(void) FT_NOEXCEPT_ { return *(this->finish_ - 1); }
+
+  const_reference back(void) const FT_NOEXCEPT_ {
+    return *(this->finish_ - 1);
+  }
+
+  // SECTION : modifiers
+  // fill
+  void assign(size_type n, const value_type& val) {
+    const value_type val_copy(val);
+    if (n > size()) {
+      std::fill(begin(), end(), val_copy);
+      PushBackN_(n - size(), val_copy);
+    } else {
+      erase(begin() + n, end());
+      std::fill(begin(), end(), val_copy);
+    }
+  }
+
+  // range : the current elements are assigned to, the rest is inserted
+  template <typename InputIterator>
+  void assign(InputIterator first,
+              typename enable_if<is_input_iterator<InputIterator>::value,
+                                 InputIterator>::type last) {
+    iterator cur = begin();
+    for (; first != last && cur != end(); ++cur, ++first) *cur = *first;
+    if (first == last)
+      erase(cur, end());
+    else
+      insert(end(), first, last);
+  }
+
+  void push_back(const value_type& val) {
+    if (this->map_ == NULL) this->InitializeMap_(0);
+    if (this->finish_.cur_ != this->finish_.last_ - 1) {
+      this->alloc_.construct(this->finish_.cur_, val);
+      ++this->finish_.cur_;
+    } else
+      PushBackAux_(val);
+  }
+
+  void push_front(const value_type& val) {
+    if (this->map_ == NULL) this->InitializeMap_(0);
+    if (this->start_.cur_ != this->start_.first_) {
+      this->alloc_.construct(this->start_.cur_ - 1, val);
+      --this->start_.cur_;
+    } else
+      PushFrontAux_(val);
+  }
+
+  void pop_back(void) FT_NOEXCEPT_ {
+    if (this->finish_.cur_ != this->finish_.first_) {
+      --this->finish_.cur_;
+      this->alloc_.destroy(this->finish_.cur_);
+    } else
+      PopBackAux_();
+  }
+
+  void pop_front(void) FT_NOEXCEPT_ {
+    if (this->start_.cur_ != this->start_.last_ - 1) {
+      this->alloc_.destroy(this->start_.cur_);
+      ++this->start_.cur_;
+    } else
+      PopFrontAux_();
+  }
+
+  // single element
+  iterator insert(iterator position, const value_type& val) {
+    const size_type elems_before = position - begin();
+    if (position.cur_ == this->start_.cur_)
+      push_front(val);
+    else if (position.cur_ == this->finish_.cur_)
+      push_back(val);
+    else
+      FillInsert_(elems_before, 1, val);
+    return begin() + elems_before;
+  }
+
+  // fill
+  void insert(iterator position, size_type n, const value_type& val) {
+    FillInsert_(position - begin(), n, val);
+  }
+
+  // range
+  template <typename InputIterator>
+  void insert(iterator position, InputIterator first,
+              typename enable_if<is_input_iterator<InputIterator>::value,
+                                 InputIterator>::type last) {
+    RangeInsert_(position - begin(), first, last);
+  }
+
+  // single element
+  iterator erase(iterator position) { return erase(position, position + 1); }
+
+  // range : the shorter side is shifted over the gap
+  iterator erase(iterator first, iterator last) {
+    const difference_type elems_before = first - begin();
+    if (first == last) return first;
+    if (first == begin() && last == end()) {
+      clear();
+      return end();
+    }
+    const difference_type n = last - first;
+    if (static_cast<size_type>(elems_before) < (size() - n) / 2) {
+      std::copy_backward(begin(), first, last);
+      for (difference_type i = 0; i < n; ++i) pop_front();
+    } else {
+      std::copy(last, end(), first);
+      for (difference_type i = 0; i < n; ++i) pop_back();
+    }
+    return begin() + elems_before;
+  }
+
+  // the map and the blocks move with their owner, iterators stay valid
+  void swap(deque& x) {
+    std::swap(this->map_, x.map_);
+    std::swap(this->map_size_, x.map_size_);
+    std::swap(this->start_, x.start_);
+    std::swap(this->finish_, x.finish_);
+    std::swap(this->alloc_, x.alloc_);
+    std::swap(this->map_alloc_, x.map_alloc_);
+  }
+
+  // keeps the block of start_ only
+  void clear(void) FT_NOEXCEPT_ {
+    if (this->map_ == NULL) return;
+    for (MapPointer_ node = this->start_.node_ + 1;
+         node < this->finish_.node_; ++node) {
+      DestroyRange_(*node, *node + this->BlockSize_());
+      this->DeallocateNode_(*node);
+    }
+    if (this->start_.node_ != this->finish_.node_) {
+      DestroyRange_(this->start_.cur_, this->start_.last_);
+      DestroyRange_(this->finish_.first_, this->finish_.cur_);
+      this->DeallocateNode_(this->finish_.first_);
+    } else
+      DestroyRange_(this->start_.cur_, this->finish_.cur_);
+    this->finish_ = this->start_;
+  }
+
+  // SECTION : allocator
+  allocator_type get_allocator(void) const FT_NOEXCEPT_ {
+    return this->alloc_;
+  }
+};
+
+// SECTION : non-member function overloads (relational operators & swap)
+template <class T, class Alloc>
+inline bool operator==(const deque<T, Alloc>& lhs,
+                       const deque<T, Alloc>& rhs) {
+  return (lhs.size() == rhs.size() &&
+          ft::equal(lhs.begin(), lhs.end(), rhs.begin()));
+}
+
+template <class T, class Alloc>
+inline bool operator!=(const deque<T, Alloc>& lhs,
+                       const deque<T, Alloc>& rhs) {
+  return !(lhs == rhs);
+}
+
+template <class T, class Alloc>
+inline bool operator<(const deque<T, Alloc>& lhs, const deque<T, Alloc>& rhs) {
+  return ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(),
+                                     rhs.end());
+}
+
+template <class T, class Alloc>
+inline bool operator<=(const deque<T, Alloc>& lhs,
+                       const deque<T, Alloc>& rhs) {
+  return !(rhs < lhs);
+}
+
+template <class T, class Alloc>
+inline bool operator>(const deque<T, Alloc>& lhs, const deque<T, Alloc>& rhs) {
+  return rhs < lhs;
+}
+
+template <class T, class Alloc>
+inline bool operator>=(const deque<T, Alloc>& lhs,
+                       const deque<T, Alloc>& rhs) {
+  return !(lhs < rhs);
+}
+
+template <class T, class Alloc>
+inline void swap(deque<T, Alloc>& x, deque<T, Alloc>& y) {
+  x.swap(y);
+}
+
+}  // namespace ft
+
+#endif
@@ -0,0 +1,469 @@
+/**
+ * @file flat_map.hpp
+ * @author ghan (ghan@student.42seoul.kr)
+ * @brief A header file for flat_map container
+ * @date 2022-07-29
+ */
+
+#ifndef FT_CONTAINERS_INCLUDES_FLAT_MAP_HPP_
+#define FT_CONTAINERS_INCLUDES_FLAT_MAP_HPP_
+
+#define FT_NOEXCEPT_ throw()
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+
+#include "algorithm.hpp"
+#include "iterator_traits.hpp"
+#include "utility.hpp"
+#include "vector.hpp"
+
+namespace ft {
+// flat_map keeps its elements sorted by key in one ft::vector : lookups are
+// binary searches over contiguous memory, a single insert or erase shifts
+// the elements after it (O(n)), and invalidates the iterators past it.
+// Elements move, so value_type is pair<Key, Value> : keys must not be
+// modified through iterators.
+template <typename Key, typename Value, typename Compare = std::less<Key>,
+          typename Alloc = std::allocator<pair<Key, Value> > >
+class flat_map {
+ public:
+  typedef Key key_type;
+  typedef Value mapped_type;
+  typedef pair<key_type, mapped_type> value_type;
+
+  class value_compare {
+    friend class flat_map;
+
+   private:
+    Compare v_comp_;
+    value_compare(Compare c) : v_comp_(c) {}
+
+   public:
+    bool operator()(const value_type& x, const value_type& y) const {
+      return v_comp_(x.first, y.first);
+    }
+  };
+
+  typedef Compare key_compare;
+  typedef typename Alloc::template rebind<value_type>::other allocator_type;
+  typedef typename allocator_type::reference reference;
+  typedef typename allocator_type::const_reference const_reference;
+  typedef typename allocator_type::pointer pointer;
+  typedef typename allocator_type::const_pointer const_pointer;
+
+ private:
+  typedef vector<value_type, allocator_type> Base_;
+
+  // the return type R of a lookup by a key of type K, if Compare is
+  // transparent (depends on K, so that it is a substitution failure)
+  template <typename K, typename R>
+  struct IfTransparent_
+      : public enable_if<has_is_transparent<Compare>::value, R> {};
+
+  key_compare comp_;
+  Base_ elems_;
+
+ public:
+  typedef typename Base_::iterator iterator;
+  typedef typename Base_::const_iterator const_iterator;
+  typedef typename Base_::const_reverse_iterator const_reverse_iterator;
+  typedef typename Base_::reverse_iterator reverse_iterator;
+  typedef typename iterator_traits<iterator>::difference_type difference_type;
+  typedef size_t size_type;
+
+ private:
+  // SECTION : search utils
+  // The halving picks a side with a conditional move, not a branch on the
+  // comparison : lookups in small tables are not bound by mispredictions
+  // among the first n elements
+  template <typename K>
+  size_type LowerIndex_(const K& key, size_type n) const {
+    if (n == 0) return 0;
+    const value_type* elems = elems_.begin().base();
+    size_type first = 0;
+    while (n > 1) {
+      const size_type half = n / 2;
+      first = comp_(elems[first + half - 1].first, key) ? first + half : first;
+      n -= half;
+    }
+    return first + comp_(elems[first].first, key);
+  }
+
+  template <typename K>
+  size_type LowerIndex_(const K& key) const {
+    return LowerIndex_(key, elems_.size());
+  }
+
+  template <typename K>
+  size_type UpperIndex_(const K& key) const {
+    size_type n = elems_.size();
+    if (n == 0) return 0;
+    const value_type* elems = elems_.begin().base();
+    size_type first = 0;
+    while (n > 1) {
+      const size_type half = n / 2;
+      first = comp_(key, elems[first + half - 1].first) ? first : first + half;
+      n -= half;
+    }
+    return first + !comp_(key, elems[first].first);
+  }
+
+  template <typename K>
+  size_type FindIndex_(const K& key) const {
+    const size_type i = LowerIndex_(key);
+    if (i == elems_.size() || comp_(key, elems_[i].first))
+      return elems_.size();
+    return i;
+  }
+
+  // SECTION : bulk insert
+  // The elements from n_old on were just appended : they are sorted (if not
+  // already), the first of each run of equivalent keys is kept unless the key
+  // was already there, and the rest is merged into place. A throwing copy or
+  // comparison before the merge drops what was appended.
+  void MergeAppended_(size_type n_old, bool sorted) {
+    value_type* first = elems_.begin().base();
+    value_type* mid = first + n_old;
+    value_type* last = elems_.end().base();
+    value_type* kept = mid;
+    try {
+      if (!sorted) std::stable_sort(mid, last, value_comp());
+      for (value_type* it = mid; it != last; ++it) {
+        if (kept != mid && !comp_((kept - 1)->first, it->first)) continue;
+        const size_type i = LowerIndex_(it->first, n_old);
+        if (i < n_old && !comp_(it->first, elems_[i].first)) continue;
+        if (kept != it) *kept = *it;
+        ++kept;
+      }
+    } catch (...) {
+      elems_.erase(elems_.begin() + n_old, elems_.end());
+      throw;
+    }
+    elems_.erase(elems_.begin() + (kept - first), elems_.end());
+    std::inplace_merge(first, mid, kept, value_comp());
+  }
+
+  template <typename InputIterator>
+  void AppendAndMerge_(InputIterator first, InputIterator last, bool sorted) {
+    const size_type n_old = elems_.size();
+    elems_.insert(elems_.end(), first, last);
+    if (elems_.size() != n_old) MergeAppended_(n_old, sorted);
+  }
+
+ public:
+  // Constructors
+  // #1 empty : empty container with no element
+  explicit flat_map(const key_compare& comp = key_compare(),
+                    const allocator_type& alloc = allocator_type())
+      : comp_(comp), elems_(alloc) {}
+
+  // #2 range : construct with as many elements as the range [first, last)
+  template <typename InputIterator>
+  flat_map(InputIterator first,
+           typename enable_if<is_input_iterator<InputIterator>::value,
+                              InputIterator>::type last,
+           const key_compare& comp = key_compare(),
+           const allocator_type& alloc = allocator_type())
+      : comp_(comp), elems_(alloc) {
+    AppendAndMerge_(first, last, false);
+  }
+
+  // #2' sorted range (ft only) : [first, last) is sorted & unique, it is
+  // copied as it is
+  template <typename InputIterator>
+  flat_map(sorted_unique_t, InputIterator first,
+           typename enable_if<is_input_iterator<InputIterator>::value,
+                              InputIterator>::type last,
+           const key_compare& comp = key_compare(),
+           const allocator_type& alloc = allocator_type())
+      : comp_(comp), elems_(first, last, alloc) {}
+
+  // #3 copy constructor
+  flat_map(const flat_map& original)
+      : comp_(original.comp_), elems_(original.elems_) {}
+
+  // Destructor
+  ~flat_map(void) FT_NOEXCEPT_ {}
+
+  // Assignment operator overload
+  flat_map& operator=(const flat_map& rhs) {
+    comp_ = rhs.comp_;
+    elems_ = rhs.elems_;
+    return *this;
+  }
+
+  // Iterators
+  iterator begin(void) FT_NOEXCEPT_ { return elems_.begin(); }
+
+  const_iterator begin(void) const FT_NOEXCEPT_ { return elems_.begin(); }
+
+  iterator end(void) FT_NOEXCEPT_ { return elems_.end(); }
+
+  const_iterator end(void) const FT_NOEXCEPT_ { return elems_.end(); }
+
+  reverse_iterator rbegin(void) FT_NOEXCEPT_ { return elems_.rbegin(); }
+
+  const_reverse_iterator rbegin(void) const FT_NOEXCEPT_ {
+    return elems_.rbegin();
+  }
+
+  reverse_iterator rend(void) FT_NOEXCEPT_ { return elems_.rend(); }
+
+  const_reverse_iterator rend(void) const FT_NOEXCEPT_ {
+    return elems_.rend();
+  }
+
+  // Capacity
+  bool empty(void) const FT_NOEXCEPT_ { return elems_.empty(); }
+
+  size_type size(void) const FT_NOEXCEPT_ { return elems_.size(); }
+
+  size_type max_size(void) const FT_NOEXCEPT_ { return elems_.max_size(); }
+
+  // room for n elements, with no reallocation until then (ft only)
+  void reserve(size_type n) { elems_.reserve(n); }
+
+  size_type capacity(void) const FT_NOEXCEPT_ { return elems_.capacity(); }
+
+  // Element Access
+  mapped_type& operator[](const key_type& key) {
+    const size_type i = LowerIndex_(key);
+    if (i == elems_.size() || comp_(key, elems_[i].first))
+      elems_.insert(elems_.begin() + i,
+                    value_type(piecewise_construct, key));
+    return elems_[i].second;
+  }
+
+  // Modifiers
+  // single element
+  pair<iterator, bool> insert(const value_type& val) {
+    const size_type i = LowerIndex_(val.first);
+    if (i < elems_.size() && !comp_(val.first, elems_[i].first))
+      return ft::make_pair(begin() + i, false);
+    return ft::make_pair(elems_.insert(elems_.begin() + i, val), true);
+  }
+
+  // single element at a given position
+  // no search when val goes right before position
+  iterator insert(iterator position, const value_type& val) {
+    if ((position == begin() || comp_((position - 1)->first, val.first)) &&
+        (position == end() || comp_(val.first, position->first)))
+      return elems_.insert(position, val);
+    return insert(val).first;
+  }
+
+  // range : appended, sorted & merged in O(n + m log m) for m new elements
+  template <typename InputIterator>
+  void insert(InputIterator first,
+              typename enable_if<is_input_iterator<InputIterator>::value,
+                                 InputIterator>::type last) {
+    AppendAndMerge_(first, last, false);
+  }
+
+  // sorted range : [first, last) is sorted & unique, only merged (ft only)
+  template <typename InputIterator>
+  void insert(sorted_unique_t, InputIterator first,
+              typename enable_if<is_input_iterator<InputIterator>::value,
+                                 InputIterator>::type last) {
+    AppendAndMerge_(first, last, true);
+  }
+
+  // try_emplace (ft only, C++17 with at most one argument for mapped_type)
+  // Nothing is constructed if key is already there
+  pair<iterator, bool> try_emplace(const key_type& key) {
+    const size_type i = LowerIndex_(key);
+    if (i < elems_.size() && !comp_(key, elems_[i].first))
+      return ft::make_pair(begin() + i, false);
+    return ft::make_pair(elems_.insert(elems_.begin() + i,
+                                       value_type(piecewise_construct, key)),
+                         true);
+  }
+
+  template <typename Arg>
+  pair<iterator, bool> try_emplace(const key_type& key, const Arg& arg) {
+    const size_type i = LowerIndex_(key);
+    if (i < elems_.size() && !comp_(key, elems_[i].first))
+      return ft::make_pair(begin() + i, false);
+    return ft::make_pair(
+        elems_.insert(elems_.begin() + i,
+                      value_type(piecewise_construct, key, arg)),
+        true);
+  }
+
+  // insert_or_assign (ft only, C++17) : the mapped value of a hit is assigned
+  // obj
+  template <typename M>
+  pair<iterator, bool> insert_or_assign(const key_type& key, const M& obj) {
+    pair<iterator, bool> ret = try_emplace(key, obj);
+    if (!ret.second) ret.first->second = obj;
+    return ret;
+  }
+
+  // single element at a given position
+  void erase(iterator position) { elems_.erase(position); }
+
+  // single element with a given key
+  size_type erase(const key_type& key) {
+    const size_type i = FindIndex_(key);
+    if (i == elems_.size()) return 0;
+    elems_.erase(elems_.begin() + i);
+    return 1;
+  }
+
+  // range
+  void erase(iterator first, iterator last) { elems_.erase(first, last); }
+
+  void swap(flat_map& x) {
+    std::swap(comp_, x.comp_);
+    elems_.swap(x.elems_);
+  }
+
+  void clear(void) FT_NOEXCEPT_ { elems_.clear(); }
+
+  // Observers
+  key_compare key_comp(void) const { return comp_; }
+
+  value_compare value_comp(void) const { return value_compare(comp_); }
+
+  // Operations
+  iterator find(const key_type& k) { return begin() + FindIndex_(k); }
+
+  const_iterator find(const key_type& k) const {
+    return begin() + FindIndex_(k);
+  }
+
+  size_type count(const key_type& k) const {
+    return FindIndex_(k) == elems_.size() ? 0 : 1;
+  }
+
+  iterator lower_bound(const key_type& key) {
+    return begin() + LowerIndex_(key);
+  }
+
+  const_iterator lower_bound(const key_type& key) const {
+    return begin() + LowerIndex_(key);
+  }
+
+  iterator upper_bound(const key_type& key) {
+    return begin() + UpperIndex_(key);
+  }
+
+  const_iterator upper_bound(const key_type& key) const {
+    return begin() + UpperIndex_(key);
+  }
+
+  pair<const_iterator, const_iterator> equal_range(const key_type& key) const {
+    return ft::make_pair(lower_bound(key), upper_bound(key));
+  }
+
+  pair<iterator, iterator> equal_range(const key_type& key) {
+    return ft::make_pair(lower_bound(key), upper_bound(key));
+  }
+
+  // heterogeneous lookup (ft only) : with a transparent Compare (e.g.
+  // ft::less<>), a key of any type Compare accepts is used as it is
+  template <typename K>
+  typename IfTransparent_<K, iterator>::type find(const K& k) {
+    return begin() + FindIndex_(k);
+  }
+
+  template <typename K>
+  typename IfTransparent_<K, const_iterator>::type find(const K& k) const {
+    return begin() + FindIndex_(k);
+  }
+
+  template <typename K>
+  typename IfTransparent_<K, size_type>::type count(const K& k) const {
+    return FindIndex_(k) == elems_.size() ? 0 : 1;
+  }
+
+  template <typename K>
+  typename IfTransparent_<K, iterator>::type lower_bound(const K& key) {
+    return begin() + LowerIndex_(key);
+  }
+
+  template <typename K>
+  typename IfTransparent_<K, const_iterator>::type lower_bound(
+      const K& key) const {
+    return begin() + LowerIndex_(key);
+  }
+
+  template <typename K>
+  typename IfTransparent_<K, iterator>::type upper_bound(const K& key) {
+    return begin() + UpperIndex_(key);
+  }
+
+  template <typename K>
+  typename IfTransparent_<K, const_iterator>::type upper_bound(
+      const K& key) const {
+    return begin() + UpperIndex_(key);
+  }
+
+  template <typename K>
+  typename IfTransparent_<K, pair<iterator, iterator> >::type equal_range(
+      const K& key) {
+    return ft::make_pair(begin() + LowerIndex_(key),
+                         begin() + UpperIndex_(key));
+  }
+
+  template <typename K>
+  typename IfTransparent_<K, pair<const_iterator, const_iterator> >::type
+  equal_range(const K& key) const {
+    return ft::make_pair(begin() + LowerIndex_(key),
+                         begin() + UpperIndex_(key));
+  }
+
+  // Allocator
+  allocator_type get_allocator(void) const FT_NOEXCEPT_ {
+    return elems_.get_allocator();
+  }
+};
+
+template <typename Key, typename T, typename Compare, typename Alloc>
+bool operator==(const flat_map<Key, T, Compare, Alloc>& lhs,
+                const flat_map<Key, T, Compare, Alloc>& rhs) {
+  return (lhs.size() == rhs.size() &&
+          ft::equal(lhs.begin(), lhs.end(), rhs.begin()));
+}
+
+template <typename Key, typename T, typename Compare, typename Alloc>
+bool operator!=(const flat_map<Key, T, Compare, Alloc>& lhs,
+                const flat_map<Key, T, Compare, Alloc>& rhs) {
+  return !(lhs == rhs);
+}
+
+template <typename Key, typename T, typename Compare, typename Alloc>
+bool operator<(const flat_map<Key, T, Compare, Alloc>& lhs,
+               const flat_map<Key, T, Compare, Alloc>& rhs) {
+  return ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(),
+                                     rhs.end());
+}
+
+template <typename Key, typename T, typename Compare, typename Alloc>
+bool operator<=(const flat_map<Key, T, Compare, Alloc>& lhs,
+                const flat_map<Key, T, Compare, Alloc>& rhs) {
+  return !(rhs < lhs);
+}
+
+template <typename Key, typename T, typename Compare, typename Alloc>
+bool operator>(const flat_map<Key, T, Compare, Alloc>& lhs,
+               const flat_map<Key, T, Compare, Alloc>& rhs) {
+  return rhs < lhs;
+}
+
+template <typename Key, typename T, typename Compare, typename Alloc>
+bool operator>=(const flat_map<Key, T, Compare, Alloc>& lhs,
+                const flat_map<Key, T, Compare, Alloc>& rhs) {
+  return !(lhs < rhs);
+}
+
+template <typename Key, typename T, typename Compare, typename Alloc>
+void swap(flat_map<Key, T, Compare, Alloc>& x,
+          flat_map<Key, T, Compare, Alloc>& y) {
+  x.swap(y);
+}
+}  // namespace ft
+
+#endif
@@ -0,0 +1,364 @@
+/**
+ * @file flat_set.hpp
+ * @author ghan (ghan@student.42seoul.kr)
+ * @brief A header file for flat_set container
+ * @date 2022-07-29
+ */
+
+#ifndef FT_CONTAINERS_INCLUDES_FLAT_SET_HPP_
+#define FT_CONTAINERS_INCLUDES_FLAT_SET_HPP_
+
+#define FT_NOEXCEPT_ throw()
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+
+#include "algorithm.hpp"
+#include "iterator_traits.hpp"
+#include "utility.hpp"
+#include "vector.hpp"
+
+namespace ft {
+// flat_set keeps its elements sorted in one ft::vector, as flat_map does :
+// binary search for lookups, O(n) shifts for a single insert or erase.
+template <typename Key, typename Compare = std::less<Key>,
+          typename Alloc = std::allocator<Key> >
+class flat_set {
+ public:
+  typedef Key key_type;
+  typedef Key value_type;
+  typedef Compare key_compare;
+  typedef Compare value_compare;
+  typedef typename Alloc::template rebind<value_type>::other allocator_type;
+  typedef typename allocator_type::reference reference;
+  typedef typename allocator_type::const_reference const_reference;
+  typedef typename allocator_type::pointer pointer;
+  typedef typename allocator_type::const_pointer const_pointer;
+
+ private:
+  typedef vector<value_type, allocator_type> Base_;
+
+  // the return type R of a lookup by a key of type K, if Compare is
+  // transparent (depends on K, so that it is a substitution failure)
+  template <typename K, typename R>
+  struct IfTransparent_
+      : public enable_if<has_is_transparent<Compare>::value, R> {};
+
+  key_compare comp_;
+  Base_ elems_;
+
+ public:
+  typedef typename Base_::const_iterator iterator;
+  typedef typename Base_::const_iterator const_iterator;
+  typedef typename Base_::const_reverse_iterator const_reverse_iterator;
+  typedef typename Base_::const_reverse_iterator reverse_iterator;
+  typedef typename iterator_traits<iterator>::difference_type difference_type;
+  typedef size_t size_type;
+
+ private:
+  // SECTION : search utils
+  // The halving picks a side with a conditional move, not a branch on the
+  // comparison : lookups in small tables are not bound by mispredictions
+  // among the first n elements
+  template <typename K>
+  size_type LowerIndex_(const K& key, size_type n) const {
+    if (n == 0) return 0;
+    const value_type* elems = elems_.begin().base();
+    size_type first = 0;
+    while (n > 1) {
+      const size_type half = n / 2;
+      first = comp_(elems[first + half - 1], key) ? first + half : first;
+      n -= half;
+    }
+    return first + comp_(elems[first], key);
+  }
+
+  template <typename K>
+  size_type LowerIndex_(const K& key) const {
+    return LowerIndex_(key, elems_.size());
+  }
+
+  template <typename K>
+  size_type UpperIndex_(const K& key) const {
+    size_type n = elems_.size();
+    if (n == 0) return 0;
+    const value_type* elems = elems_.begin().base();
+    size_type first = 0;
+    while (n > 1) {
+      const size_type half = n / 2;
+      first = comp_(key, elems[first + half - 1]) ? first : first + half;
+      n -= half;
+    }
+    return first + !comp_(key, elems[first]);
+  }
+
+  template <typename K>
+  size_type FindIndex_(const K& key) const {
+    const size_type i = LowerIndex_(key);
+    if (i == elems_.size() || comp_(key, elems_[i])) return elems_.size();
+    return i;
+  }
+
+  // the mutable position of the vector at itr
+  typename Base_::iterator Mutable_(const_iterator itr) {
+    return elems_.begin() + (itr - begin());
+  }
+
+  // SECTION : bulk insert
+  // same as flat_map::MergeAppended_
+  void MergeAppended_(size_type n_old, bool sorted) {
+    value_type* first = elems_.begin().base();
+    value_type* mid = first + n_old;
+    value_type* last = elems_.end().base();
+    value_type* kept = mid;
+    try {
+      if (!sorted) std::stable_sort(mid, last, comp_);
+      for (value_type* it = mid; it != last; ++it) {
+        if (kept != mid && !comp_(*(kept - 1), *it)) continue;
+        const size_type i = LowerIndex_(*it, n_old);
+        if (i < n_old && !comp_(*it, elems_[i])) continue;
+        if (kept != it) *kept = *it;
+        ++kept;
+      }
+    } catch (...) {
+      elems_.erase(elems_.begin() + n_old, elems_.end());
+      throw;
+    }
+    elems_.erase(elems_.begin() + (kept - first), elems_.end());
+    std::inplace_merge(first, mid, kept, comp_);
+  }
+
+  template <typename InputIterator>
+  void AppendAndMerge_(InputIterator first, InputIterator last, bool sorted) {
+    const size_type n_old = elems_.size();
+    elems_.insert(elems_.end(), first, last);
+    if (elems_.size() != n_old) MergeAppended_(n_old, sorted);
+  }
+
+ public:
+  // Constructors
+  // #1 empty : empty container with no element
+  explicit flat_set(const key_compare& comp = key_compare(),
+                    const allocator_type& alloc = allocator_type())
+      : comp_(comp), elems_(alloc) {}
+
+  // #2 range : construct with as many elements as the range [first, last)
+  template <typename InputIterator>
+  flat_set(InputIterator first,
+           typename enable_if<is_input_iterator<InputIterator>::value,
+                              InputIterator>::type last,
+           const key_compare& comp = key_compare(),
+           const allocator_type& alloc = allocator_type())
+      : comp_(comp), elems_(alloc) {
+    AppendAndMerge_(first, last, false);
+  }
+
+  // #2' sorted range (ft only) : [first, last) is sorted & unique, it is
+  // copied as it is
+  template <typename InputIterator>
+  flat_set(sorted_unique_t, InputIterator first,
+           typename enable_if<is_input_iterator<InputIterator>::value,
+                              InputIterator>::type last,
+           const key_compare& comp = key_compare(),
+           const allocator_type& alloc = allocator_type())
+      : comp_(comp), elems_(first, last, alloc) {}
+
+  // #3 copy constructor
+  flat_set(const flat_set& original)
+      : comp_(original.comp_), elems_(original.elems_) {}
+
+  // Destructor
+  ~flat_set(void) FT_NOEXCEPT_ {}
+
+  // Assignment operator overload
+  flat_set& operator=(const flat_set& rhs) {
+    comp_ = rhs.comp_;
+    elems_ = rhs.elems_;
+    return *this;
+  }
+
+  // Iterators
+  iterator begin(void) const FT_NOEXCEPT_ { return elems_.begin(); }
+
+  iterator end(void) const FT_NOEXCEPT_ { return elems_.end(); }
+
+  reverse_iterator rbegin(void) const FT_NOEXCEPT_ { return elems_.rbegin(); }
+
+  reverse_iterator rend(void) const FT_NOEXCEPT_ { return elems_.rend(); }
+
+  // Capacity
+  bool empty(void) const FT_NOEXCEPT_ { return elems_.empty(); }
+
+  size_type size(void) const FT_NOEXCEPT_ { return elems_.size(); }
+
+  size_type max_size(void) const FT_NOEXCEPT_ { return elems_.max_size(); }
+
+  // room for n elements, with no reallocation until then (ft only)
+  void reserve(size_type n) { elems_.reserve(n); }
+
+  size_type capacity(void) const FT_NOEXCEPT_ { return elems_.capacity(); }
+
+  // Modifiers
+  // single element
+  pair<iterator, bool> insert(const value_type& val) {
+    const size_type i = LowerIndex_(val);
+    if (i < elems_.size() && !comp_(val, elems_[i]))
+      return ft::make_pair(begin() + i, false);
+    return ft::make_pair(iterator(elems_.insert(elems_.begin() + i, val)),
+                         true);
+  }
+
+  // single element at a given position
+  // no search when val goes right before position
+  iterator insert(iterator position, const value_type& val) {
+    if ((position == begin() || comp_(*(position - 1), val)) &&
+        (position == end() || comp_(val, *position)))
+      return elems_.insert(Mutable_(position), val);
+    return insert(val).first;
+  }
+
+  // range : appended, sorted & merged in O(n + m log m) for m new elements
+  template <typename InputIterator>
+  void insert(InputIterator first,
+              typename enable_if<is_input_iterator<InputIterator>::value,
+                                 InputIterator>::type last) {
+    AppendAndMerge_(first, last, false);
+  }
+
+  // sorted range : [first, last) is sorted & unique, only merged (ft only)
+  template <typename InputIterator>
+  void insert(sorted_unique_t, InputIterator first,
+              typename enable_if<is_input_iterator<InputIterator>::value,
+                                 InputIterator>::type last) {
+    AppendAndMerge_(first, last, true);
+  }
+
+  // single element at a given position
+  void erase(iterator position) { elems_.erase(Mutable_(position)); }
+
+  // single element with a given value
+  size_type erase(const value_type& val) {
+    const size_type i = FindIndex_(val);
+    if (i == elems_.size()) return 0;
+    elems_.erase(elems_.begin() + i);
+    return 1;
+  }
+
+  // range
+  void erase(iterator first, iterator last) {
+    elems_.erase(Mutable_(first), Mutable_(last));
+  }
+
+  void swap(flat_set& x) {
+    std::swap(comp_, x.comp_);
+    elems_.swap(x.elems_);
+  }
+
+  void clear(void) FT_NOEXCEPT_ { elems_.clear(); }
+
+  // Observers
+  key_compare key_comp(void) const { return comp_; }
+
+  value_compare value_comp(void) const { return comp_; }
+
+  // Operations
+  iterator find(const value_type& val) const {
+    return begin() + FindIndex_(val);
+  }
+
+  size_type count(const value_type& val) const {
+    return FindIndex_(val) == elems_.size() ? 0 : 1;
+  }
+
+  iterator lower_bound(const value_type& val) const {
+    return begin() + LowerIndex_(val);
+  }
+
+  iterator upper_bound(const value_type& val) const {
+    return begin() + UpperIndex_(val);
+  }
+
+  pair<iterator, iterator> equal_range(const value_type& val) const {
+    return ft::make_pair(lower_bound(val), upper_bound(val));
+  }
+
+  // heterogeneous lookup (ft only) : with a transparent Compare (e.g.
+  // ft::less<>), a key of any type Compare accepts is used as it is
+  template <typename K>
+  typename IfTransparent_<K, iterator>::type find(const K& k) const {
+    return begin() + FindIndex_(k);
+  }
+
+  template <typename K>
+  typename IfTransparent_<K, size_type>::type count(const K& k) const {
+    return FindIndex_(k) == elems_.size() ? 0 : 1;
+  }
+
+  template <typename K>
+  typename IfTransparent_<K, iterator>::type lower_bound(const K& k) const {
+    return begin() + LowerIndex_(k);
+  }
+
+  template <typename K>
+  typename IfTransparent_<K, iterator>::type upper_bound(const K& k) const {
+    return begin() + UpperIndex_(k);
+  }
+
+  template <typename K>
+  typename IfTransparent_<K, pair<iterator, iterator> >::type equal_range(
+      const K& k) const {
+    return ft::make_pair(begin() + LowerIndex_(k), begin() + UpperIndex_(k));
+  }
+
+  // Allocator
+  allocator_type get_allocator(void) const FT_NOEXCEPT_ {
+    return elems_.get_allocator();
+  }
+};
+
+template <typename Key, typename Compare, typename Alloc>
+bool operator==(const flat_set<Key, Compare, Alloc>& lhs,
+                const flat_set<Key, Compare, Alloc>& rhs) {
+  return (lhs.size() == rhs.size() &&
+          ft::equal(lhs.begin(), lhs.end(), rhs.begin()));
+}
+
+template <typename Key, typename Compare, typename Alloc>
+bool operator!=(const flat_set<Key, Compare, Alloc>& lhs,
+                const flat_set<Key, Compare, Alloc>& rhs) {
+  return !(lhs == rhs);
+}
+
+template <typename Key, typename Compare, typename Alloc>
+bool operator<(const flat_set<Key, Compare, Alloc>& lhs,
+               const flat_set<Key, Compare, Alloc>& rhs) {
+  return ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(),
+                                     rhs.end());
+}
+
+template <typename Key, typename Compare, typename Alloc>
+bool operator<=(const flat_set<Key, Compare, Alloc>& lhs,
+                const flat_set<Key, Compare, Alloc>& rhs) {
+  return !(rhs < lhs);
+}
+
+template <typename Key, typename Compare, typename Alloc>
+bool operator>(const flat_set<Key, Compare, Alloc>& lhs,
+               const flat_set<Key, Compare, Alloc>& rhs) {
+  return rhs < lhs;
+}
+
+template <typename Key, typename Compare, typename Alloc>
+bool operator>=(const flat_set<Key, Compare, Alloc>& lhs,
+                const flat_set<Key, Compare, Alloc>& rhs) {
+  return !(lhs < rhs);
+}
+
+template <typename Key, typename Compare, typename Alloc>
+void swap(flat_set<Key, Compare, Alloc>& x, flat_set<Key, Compare, Alloc>& y) {
+  x.swap(y);
+}
+}  // namespace ft
+
+#endif
@@ -12,6 +12,7 @@
 
 #include <functional>
 #include <memory>
+#include <new>
 
 #include "algorithm.hpp"
 #include "iterator_traits.hpp"
@@ -19,8 +20,11 @@
 #include "utility.hpp"
 
 namespace ft {
+// Augment is no_order_statistics, order_statistics for nth, rank &
+// count_range, or threaded for O(1) iterator steps (ft only)
 template <typename Key, typename Value, typename Compare = std::less<Key>,
-          typename Alloc = std::allocator<pair<const Key, Value> > >
+          typename Alloc = std::allocator<pair<const Key, Value> >,
+          typename Augment = no_order_statistics>
 class map {
  public:
   typedef Key key_type;
@@ -48,10 +52,44 @@ class map {
   typedef typename allocator_type::const_pointer const_pointer;
 
  private:
-  typedef RbTree<value_type, value_compare, allocator_type> Base_;
+  typedef RbTree<value_type, RbTreeSelectFirst<value_type>, key_compare,
+                 allocator_type, Augment>
+      Base_;
   typedef typename Base_::Node Node_;
   typedef typename Base_::NodePtr NodePtr_;
 
+  // the return type R of a lookup by a key of type K, if Compare is
+  // transparent (depends on K, so that it is a substitution failure)
+  template <typename K, typename R>
+  struct IfTransparent_
+      : public enable_if<has_is_transparent<Compare>::value, R> {};
+
+  // makers for Base_::Emplace : build the value of a new node in place, from
+  // the key and either nothing (mapped_type is value-initialized) or one
+  // argument for mapped_type's constructor
+  struct MakeDefault_ {
+    const key_type& key;
+
+    explicit MakeDefault_(const key_type& k) : key(k) {}
+
+    void operator()(allocator_type&, pointer ptr) const {
+      ::new (static_cast<void*>(ptr)) value_type(piecewise_construct, key);
+    }
+  };
+
+  template <typename Arg>
+  struct MakeFrom_ {
+    const key_type& key;
+    const Arg& arg;
+
+    MakeFrom_(const key_type& k, const Arg& a) : key(k), arg(a) {}
+
+    void operator()(allocator_type&, pointer ptr) const {
+      ::new (static_cast<void*>(ptr))
+          value_type(piecewise_construct, key, arg);
+    }
+  };
+
   key_compare comp_;
   allocator_type alloc_;
   Base_ tree_;
@@ -68,7 +106,7 @@ class map {
   // #1 empty : empty container with no element
   explicit map(const key_compare& comp = key_compare(),
                const allocator_type& alloc = allocator_type())
-      : comp_(comp), alloc_(alloc), tree_(Base_(value_comp(), alloc)) {}
+      : comp_(comp), alloc_(alloc), tree_(comp, alloc) {}
 
   // #2 range : construct with as many elements as the range [first, last)
   template <typename InputIterator>
@@ -77,15 +115,27 @@ class map {
                          InputIterator>::type last,
       const key_compare& comp = key_compare(),
       const allocator_type& alloc = allocator_type())
-      : comp_(comp), alloc_(alloc), tree_(Base_(value_comp(), alloc)) {
-    for (; first != last; ++first) insert(*first);
+      : comp_(comp), alloc_(alloc), tree_(comp, alloc) {
+    tree_.InsertRange(first, last);
+  }
+
+  // #2' sorted range (ft only) : [first, last) is sorted & unique, the tree
+  // is built in O(n)
+  template <typename InputIterator>
+  map(sorted_unique_t, InputIterator first,
+      typename enable_if<is_input_iterator<InputIterator>::value,
+                         InputIterator>::type last,
+      const key_compare& comp = key_compare(),
+      const allocator_type& alloc = allocator_type())
+      : comp_(comp), alloc_(alloc), tree_(comp, alloc) {
+    tree_.InsertSortedUnique(first, last);
   }
 
   // #3 copy constructor
   map(const map& original)
       : comp_(original.comp_),
         alloc_(original.alloc_),
-        tree_(Base_(original.tree_)) {}
+        tree_(original.tree_) {}
 
   // Destructor
   ~map(void) FT_NOEXCEPT_ {}
@@ -94,8 +144,7 @@ class map {
   map& operator=(const map& rhs) {
     comp_ = rhs.comp_;
     alloc_ = rhs.alloc_;
-    tree_.~Base_();
-    tree_ = Base_(rhs.tree_);
+    tree_ = rhs.tree_;
     return *this;
   }
 
@@ -125,9 +174,14 @@ class map {
 
   size_type max_size(void) const FT_NOEXCEPT_ { return tree_.MaxSize(); }
 
+  // pre-sizes the node pool for n elements (ft only)
+  void reserve(size_type n) { tree_.Reserve(n); }
+
   // Element Access
+  // looks key up first : a hit constructs nothing, a miss value-initializes
+  // the mapped value right in the new node
   mapped_type& operator[](const key_type& key) {
-    return (*(insert(ft::make_pair(key, mapped_type())).first)).second;
+    return tree_.Emplace(key, MakeDefault_(key)).first->second;
   }
 
   // Modifiers
@@ -137,10 +191,9 @@ class map {
   }
 
   // single element at a given position
+  // O(1) amortized when val goes right before or after position
   iterator insert(iterator position, const value_type& val) {
-    return (position != end() && val.first > (*position).first)
-               ? tree_.Insert(val, position.base()).first
-               : insert(val).first;
+    return tree_.Insert(val, position.base()).first;
   }
 
   // range
@@ -148,7 +201,53 @@ class map {
   void insert(InputIterator first,
               typename enable_if<is_input_iterator<InputIterator>::value,
                                  InputIterator>::type last) {
-    for (; first != last; ++first) insert(*first);
+    tree_.InsertRange(first, last);
+  }
+
+  // sorted range : [first, last) is sorted & unique (ft only)
+  template <typename InputIterator>
+  void insert(sorted_unique_t, InputIterator first,
+              typename enable_if<is_input_iterator<InputIterator>::value,
+                                 InputIterator>::type last) {
+    tree_.InsertSortedUnique(first, last);
+  }
+
+  // try_emplace (ft only, C++17 with at most one argument for mapped_type)
+  // Nothing is constructed if key is already there, otherwise the mapped
+  // value is built from arg in the new node, without a temporary
+  pair<iterator, bool> try_emplace(const key_type& key) {
+    return tree_.Emplace(key, MakeDefault_(key));
+  }
+
+  template <typename Arg>
+  pair<iterator, bool> try_emplace(const key_type& key, const Arg& arg) {
+    return tree_.Emplace(key, MakeFrom_<Arg>(key, arg));
+  }
+
+  iterator try_emplace(iterator hint, const key_type& key) {
+    return tree_.Emplace(key, MakeDefault_(key), hint.base()).first;
+  }
+
+  template <typename Arg>
+  iterator try_emplace(iterator hint, const key_type& key, const Arg& arg) {
+    return tree_.Emplace(key, MakeFrom_<Arg>(key, arg), hint.base()).first;
+  }
+
+  // insert_or_assign (ft only, C++17) : the mapped value of a hit is assigned
+  // obj, a miss builds it from obj in the new node
+  template <typename M>
+  pair<iterator, bool> insert_or_assign(const key_type& key, const M& obj) {
+    pair<iterator, bool> ret = tree_.Emplace(key, MakeFrom_<M>(key, obj));
+    if (!ret.second) ret.first->second = obj;
+    return ret;
+  }
+
+  template <typename M>
+  iterator insert_or_assign(iterator hint, const key_type& key, const M& obj) {
+    pair<iterator, bool> ret =
+        tree_.Emplace(key, MakeFrom_<M>(key, obj), hint.base());
+    if (!ret.second) ret.first->second = obj;
+    return ret.first;
   }
 
   // sigle element at a given position
@@ -156,25 +255,31 @@ class map {
 
   // single element with a given key
   size_type erase(const key_type& key) {
-    size_type original = size();
-    tree_.Delete(NULL, ft::make_pair(key, mapped_type()));
-    return original - size();
+    iterator position = find(key);
+    if (position == end()) return 0;
+    erase(position);
+    return 1;
   }
 
   // range
   void erase(iterator first, iterator last) {
-    iterator tmp;
-    for (; first != last;) {
-      tmp = first;
-      ++tmp;
-      tree_.Delete(first.base());
-      first = tmp;
-    }
+    tree_.DeleteRange(first.base(), last.base());
   }
 
   void swap(map& x) { tree_.Swap(x.tree_); }
 
-  void clear(void) FT_NOEXCEPT_ { tree_.ClearPostOrder(tree_.GetRoot()); }
+  void clear(void) FT_NOEXCEPT_ { tree_.Clear(); }
+
+  // split & join (ft only)
+  // moves the elements not less than key to greater, which is cleared first
+  void split(const key_type& key, map& greater) {
+    tree_.Split(key, greater.tree_);
+  }
+
+  // moves the elements of other into this map : O(log n) when all the keys of
+  // one come before all the keys of the other, otherwise like insert(), and
+  // the elements whose key is already here stay in other
+  void join(map& other) { tree_.Join(other.tree_); }
 
   // Observers
   key_compare key_comp(void) const { return comp_; }
@@ -182,32 +287,25 @@ class map {
   value_compare value_comp(void) const { return value_compare(comp_); }
 
   // Operations
-  iterator find(const key_type& k) {
-    return tree_.Search(ft::make_pair(k, mapped_type()));
-  }
+  // keys are compared as they are, with no value_type built around them
+  iterator find(const key_type& k) { return tree_.Search(k); }
 
-  const_iterator find(const key_type& k) const {
-    return const_iterator(tree_.Search(ft::make_pair(k, mapped_type())).base());
-  }
+  const_iterator find(const key_type& k) const { return tree_.Search(k); }
 
   size_type count(const key_type& k) const {
-    return tree_.Search(ft::make_pair(k, mapped_type())) == end() ? 0 : 1;
+    return tree_.Search(k) == end() ? 0 : 1;
   }
 
-  iterator lower_bound(const key_type& key) {
-    return tree_.LowerBound(ft::make_pair(key, mapped_type()));
-  }
+  iterator lower_bound(const key_type& key) { return tree_.LowerBound(key); }
 
   const_iterator lower_bound(const key_type& key) const {
-    return tree_.LowerBound(ft::make_pair(key, mapped_type()));
+    return tree_.LowerBound(key);
   }
 
-  iterator upper_bound(const key_type& key) {
-    return tree_.UpperBound(ft::make_pair(key, mapped_type()));
-  }
+  iterator upper_bound(const key_type& key) { return tree_.UpperBound(key); }
 
   const_iterator upper_bound(const key_type& key) const {
-    return tree_.UpperBound(ft::make_pair(key, mapped_type()));
+    return tree_.UpperBound(key);
   }
 
   pair<const_iterator, const_iterator> equal_range(const key_type& key) const {
@@ -218,50 +316,127 @@ class map {
     return ft::make_pair(lower_bound(key), upper_bound(key));
   }
 
+  // heterogeneous lookup (ft only) : with a transparent Compare (e.g.
+  // ft::less<>), a key of any type Compare accepts is used as it is
+  template <typename K>
+  typename IfTransparent_<K, iterator>::type find(const K& k) {
+    return tree_.Search(k);
+  }
+
+  template <typename K>
+  typename IfTransparent_<K, const_iterator>::type find(const K& k) const {
+    return tree_.Search(k);
+  }
+
+  template <typename K>
+  typename IfTransparent_<K, size_type>::type count(const K& k) const {
+    return tree_.Search(k) == end() ? 0 : 1;
+  }
+
+  template <typename K>
+  typename IfTransparent_<K, iterator>::type lower_bound(const K& key) {
+    return tree_.LowerBound(key);
+  }
+
+  template <typename K>
+  typename IfTransparent_<K, const_iterator>::type lower_bound(
+      const K& key) const {
+    return tree_.LowerBound(key);
+  }
+
+  template <typename K>
+  typename IfTransparent_<K, iterator>::type upper_bound(const K& key) {
+    return tree_.UpperBound(key);
+  }
+
+  template <typename K>
+  typename IfTransparent_<K, const_iterator>::type upper_bound(
+      const K& key) const {
+    return tree_.UpperBound(key);
+  }
+
+  template <typename K>
+  typename IfTransparent_<K, pair<iterator, iterator> >::type equal_range(
+      const K& key) {
+    return ft::make_pair(tree_.LowerBound(key), tree_.UpperBound(key));
+  }
+
+  template <typename K>
+  typename IfTransparent_<K, pair<const_iterator, const_iterator> >::type
+  equal_range(const K& key) const {
+    return ft::make_pair(const_iterator(tree_.LowerBound(key)),
+                         const_iterator(tree_.UpperBound(key)));
+  }
+
+  // Order statistics (ft only, with order_statistics as Augment)
+  // the k-th smallest element (from 0) in O(log n), end() if k >= size()
+  iterator nth(size_type k) { return tree_.Select(k); }
+
+  const_iterator nth(size_type k) const { return tree_.Select(k); }
+
+  // the number of elements less than key, in O(log n)
+  size_type rank(const key_type& key) const {
+    return tree_.Rank(key);
+  }
+
+  // the number of elements in [lo, hi), in O(log n)
+  size_type count_range(const key_type& lo, const key_type& hi) const {
+    if (!comp_(lo, hi)) return 0;
+    return tree_.Rank(hi) - tree_.Rank(lo);
+  }
+
   // Allocator
   allocator_type get_allocator(void) const FT_NOEXCEPT_ { return alloc_; }
 };
 
-template <typename Key, typename T, typename Compare, typename Alloc>
-bool operator==(const map<Key, T, Compare, Alloc>& lhs,
-                const map<Key, T, Compare, Alloc>& rhs) {
+template <typename Key, typename T, typename Compare, typename Alloc,
+          typename Augment>
+bool operator==(const map<Key, T, Compare, Alloc, Augment>& lhs,
+                const map<Key, T, Compare, Alloc, Augment>& rhs) {
   return (lhs.size() == rhs.size() &&
-          equal(lhs.begin(), lhs.end(), rhs.begin()));
+          ft::equal(lhs.begin(), lhs.end(), rhs.begin()));
 }
 
-template <typename Key, typename T, typename Compare, typename Alloc>
-bool operator!=(const map<Key, T, Compare, Alloc>& lhs,
-                const map<Key, T, Compare, Alloc>& rhs) {
+template <typename Key, typename T, typename Compare, typename Alloc,
+          typename Augment>
+bool operator!=(const map<Key, T, Compare, Alloc, Augment>& lhs,
+                const map<Key, T, Compare, Alloc, Augment>& rhs) {
   return !(lhs == rhs);
 }
 
-template <typename Key, typename T, typename Compare, typename Alloc>
-bool operator<(const map<Key, T, Compare, Alloc>& lhs,
-               const map<Key, T, Compare, Alloc>& rhs) {
-  return lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(),
-                                 rhs.end());
+template <typename Key, typename T, typename Compare, typename Alloc,
+          typename Augment>
+bool operator<(const map<Key, T, Compare, Alloc, Augment>& lhs,
+               const map<Key, T, Compare, Alloc, Augment>& rhs) {
+  return ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(),
+                                     rhs.end());
 }
 
-template <typename Key, typename T, typename Compare, typename Alloc>
-bool operator<=(const map<Key, T, Compare, Alloc>& lhs,
-                const map<Key, T, Compare, Alloc>& rhs) {
+template <typename Key, typename T, typename Compare, typename Alloc,
+          typename Augment>
+bool operator<=(const map<Key, T, Compare, Alloc, Augment>& lhs,
+                const map<Key, T, Compare, Alloc, Augment>& rhs) {
   return !(rhs < lhs);
 }
 
-template <typename Key, typename T, typename Compare, typename Alloc>
-bool operator>(const map<Key, T, Compare, Alloc>& lhs,
-               const map<Key, T, Compare, Alloc>& rhs) {
+template <typename Key, typename T, typename Compare, typename Alloc,
+          typename Augment>
+bool operator>(const map<Key, T, Compare, Alloc, Augment>& lhs,
+               const map<Key, T, Compare, Alloc, Augment>& rhs) {
   return rhs < lhs;
 }
 
-template <typename Key, typename T, typename Compare, typename Alloc>
-bool operator>=(const map<Key, T, Compare, Alloc>& lhs,
-                const map<Key, T, Compare, Alloc>& rhs) {
+template <typename Key, typename T, typename Compare, typename Alloc,
+          typename Augment>
+bool operator>=(const map<Key, T, Compare, Alloc, Augment>& lhs,
+                const map<Key, T, Compare, Alloc, Augment>& rhs) {
   return !(lhs < rhs);
 }
 
-template <typename Key, typename T, typename Compare, typename Alloc>
-void swap(map<Key, T, Compare, Alloc>& x, map<Key, T, Compare, Alloc>& y) {
+template <typename Key, typename T, typename Compare, typename Alloc,
+          typename Augment>
+void swap(map<Key, T, Compare, Alloc, Augment>& x,
+          map<Key, T, Compare, Alloc, Augment>& y) {
   x.swap(y);
 }
 }  // namespace ft
@@ -0,0 +1,361 @@
+/**
+ * @file mapped_vector.hpp
+ * @author ghan (ghan@student.42seoul.kr)
+ * @brief A header file for mapped_vector container (file-backed vector)
+ * @date 2022-07-14
+ */
+
+#ifndef FT_CONTAINERS_INCLUDES_MAPPED_VECTOR_HPP_
+#define FT_CONTAINERS_INCLUDES_MAPPED_VECTOR_HPP_
+
+#define FT_NOEXCEPT_ throw()
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <new>
+#include <stdexcept>
+#include <string>
+
+#include "iterator_traits.hpp"
+#include "type_traits.hpp"
+#include "vector.hpp"
+
+namespace ft {
+
+// SECTION : file layout
+// [header (header_size bytes)][element 0][element 1]...
+// The header is padded so that the elements are suitably aligned, the file
+// may be longer than the elements (the rest is capacity).
+struct MappedVectorHeader {
+  char magic[8];
+  size_t elem_size;
+  size_t size;
+};
+
+// SECTION : mapped_vector
+// A vector of trivially copyable elements whose storage is a shared mapping
+// of a file. Opening a file maps it without reading it : pages are faulted in
+// on first access, and whatever is written lands in the file. Growth extends
+// the file with ftruncate and remaps it (mremap on Linux).
+// NOTE : like any reallocation, growth invalidates pointers and iterators
+template <typename T>
+class mapped_vector {
+ public:
+  // SECTION : member types
+  typedef T value_type;
+  typedef size_t size_type;
+  typedef ptrdiff_t difference_type;
+  typedef T* pointer;
+  typedef const T* const_pointer;
+  typedef value_type& reference;
+  typedef const value_type& const_reference;
+  typedef VectorIterator<const_pointer> const_iterator;
+  typedef VectorIterator<pointer> iterator;
+  typedef reverse_iterator<const_iterator> const_reverse_iterator;
+  typedef reverse_iterator<iterator> reverse_iterator;
+
+  static const size_type header_size = 64;
+
+ private:
+  // elements are stored and reloaded as raw bytes
+  typedef char TriviallyCopyableCheck_[is_trivially_copyable<T>::value ? 1
+                                                                       : -1];
+
+  int fd_;
+  char* map_;          // start of the mapping (the header)
+  size_type map_size_;  // bytes mapped, i.e. the file size
+
+  // non-copyable : two objects would own the same file
+  mapped_vector(const mapped_vector&);
+  mapped_vector& operator=(const mapped_vector&);
+
+  static const char* Magic_(void) { return "FTMAPVEC"; }
+
+  MappedVectorHeader* Header_(void) const {
+    return reinterpret_cast<MappedVectorHeader*>(map_);
+  }
+
+  pointer Data_(void) const {
+    return reinterpret_cast<pointer>(map_ + header_size);
+  }
+
+  static void Throw_(const std::string& what) {
+    throw std::runtime_error("mapped_vector: " + what + ": " +
+                             std::strerror(errno));
+  }
+
+  static size_type FileSize_(size_type n_elem) {
+    return header_size + n_elem * sizeof(value_type);
+  }
+
+  // map_size_ bytes of fd_, shared with the file
+  void Map_(void) {
+    void* ptr = mmap(NULL, map_size_, PROT_READ | PROT_WRITE, MAP_SHARED,
+                     fd_, 0);
+    if (ptr == MAP_FAILED) Throw_("mmap");
+    map_ = static_cast<char*>(ptr);
+  }
+
+  // resize the file to hold n_alloc elements and follow it with the mapping
+  void Remap_(size_type n_alloc) {
+    const size_type new_size = FileSize_(n_alloc);
+    if (ftruncate(fd_, new_size) != 0) Throw_("ftruncate");
+#if defined(__linux__) && defined(MREMAP_MAYMOVE)
+    void* ptr = mremap(map_, map_size_, new_size, MREMAP_MAYMOVE);
+    if (ptr == MAP_FAILED) Throw_("mremap");
+    map_ = static_cast<char*>(ptr);
+    map_size_ = new_size;
+#else
+    munmap(map_, map_size_);
+    map_ = NULL;
+    map_size_ = new_size;
+    Map_();
+#endif
+  }
+
+  size_type NextCapacity_(size_type required) const {
+    if (required > max_size())
+      throw std::length_error("mapped_vector cannot grow larger than max_size");
+    // at least a page of elements, then doubling
+    const size_type next = std::max(std::max(capacity() * 2, required),
+                                    4096 / sizeof(value_type) + 1);
+    return std::min(next, max_size());
+  }
+
+  void Release_(void) FT_NOEXCEPT_ {
+    if (map_ != NULL) munmap(map_, map_size_);
+    if (fd_ != -1) ::close(fd_);
+    fd_ = -1;
+    map_ = NULL;
+    map_size_ = 0;
+  }
+
+ public:
+  // SECTION : constructors & destructor
+  // #1 default : not attached to a file, open() before use
+  mapped_vector(void) : fd_(-1), map_(NULL), map_size_(0) {}
+
+  // #2 open (or create) the file at path
+  explicit mapped_vector(const char* path)
+      : fd_(-1), map_(NULL), map_size_(0) {
+    open(path);
+  }
+
+  // destructor
+  ~mapped_vector(void) FT_NOEXCEPT_ { close(); }
+
+  // SECTION : file
+  // an existing file must have been written by a mapped_vector<T>, a new or
+  // empty one is initialized. Nothing but the header is read : its size is
+  // checked against the file without multiplying it, which could wrap.
+  void open(const char* path) {
+    close();
+    fd_ = ::open(path, O_RDWR | O_CREAT, 0644);
+    if (fd_ == -1) Throw_(std::string("open ") + path);
+    try {
+      struct stat st;
+      if (fstat(fd_, &st) != 0) Throw_("fstat");
+      const bool is_new = (st.st_size == 0);
+      map_size_ = is_new ? FileSize_(0) : static_cast<size_type>(st.st_size);
+      if (is_new && ftruncate(fd_, map_size_) != 0) Throw_("ftruncate");
+      if (map_size_ < header_size)
+        throw std::runtime_error("mapped_vector: truncated file");
+      Map_();
+      MappedVectorHeader* header = Header_();
+      if (is_new) {
+        std::memcpy(header->magic, Magic_(), sizeof(header->magic));
+        header->elem_size = sizeof(value_type);
+        header->size = 0;
+      } else if (std::memcmp(header->magic, Magic_(), sizeof(header->magic)) ||
+                 header->elem_size != sizeof(value_type) ||
+                 header->size > (map_size_ - header_size) / sizeof(value_type))
+        throw std::runtime_error("mapped_vector: not a mapped_vector file");
+    } catch (...) {
+      Release_();
+      throw;
+    }
+  }
+
+  // trims the file to the elements and detaches from it
+  void close(void) FT_NOEXCEPT_ {
+    if (!is_open()) return;
+    const size_type file_size = FileSize_(size());
+    munmap(map_, map_size_);
+    map_ = NULL;
+    // best effort : a file which keeps its capacity is valid as well
+    const int trimmed = ftruncate(fd_, file_size);
+    static_cast<void>(trimmed);
+    Release_();
+  }
+
+  bool is_open(void) const FT_NOEXCEPT_ { return map_ != NULL; }
+
+  // blocks until the mapped pages are written back to the file
+  void flush(void) {
+    if (is_open() && msync(map_, map_size_, MS_SYNC) != 0) Throw_("msync");
+  }
+
+  // SECTION : iterators
+  iterator begin(void) FT_NOEXCEPT_ { return iterator(data()); }
+
+  const_iterator begin(void) const FT_NOEXCEPT_ {
+    return const_iterator(data());
+  }
+
+  iterator end(void) FT_NOEXCEPT_ { return iterator(data() + size()); }
+
+  const_iterator end(void) const FT_NOEXCEPT_ {
+    return const_iterator(data() + size());
+  }
+
+  reverse_iterator rbegin(void) FT_NOEXCEPT_ { return reverse_iterator(end()); }
+
+  const_reverse_iterator rbegin(void) const FT_NOEXCEPT_ {
+    return const_reverse_iterator(end());
+  }
+
+  reverse_iterator rend(void) FT_NOEXCEPT_ { return reverse_iterator(begin()); }
+
+  const_reverse_iterator rend(void) const FT_NOEXCEPT_ {
+    return const_reverse_iterator(begin());
+  }
+
+  // SECTION : capacity
+  size_type size(void) const FT_NOEXCEPT_ {
+    return is_open() ? Header_()->size : 0;
+  }
+
+  size_type max_size(void) const FT_NOEXCEPT_ {
+    return (std::numeric_limits<size_type>::max() - header_size) /
+           sizeof(value_type);
+  }
+
+  // growing a closed mapped_vector throws as reserve does, resize(0) on it
+  // is a no-op
+  void resize(size_type n, value_type val = value_type()) {
+    if (n > size()) {
+      if (n > capacity()) reserve(n);
+      std::uninitialized_fill(data() + size(), data() + n, val);
+    }
+    if (is_open()) Header_()->size = n;
+  }
+
+  size_type capacity(void) const FT_NOEXCEPT_ {
+    return is_open() ? (map_size_ - header_size) / sizeof(value_type) : 0;
+  }
+
+  bool empty(void) const FT_NOEXCEPT_ { return size() == 0; }
+
+  void reserve(size_type n) {
+    if (!is_open()) throw std::logic_error("mapped_vector: no file is open");
+    if (n > max_size())
+      throw std::length_error("cannot reserve capacity larger than max_size");
+    if (n > capacity()) Remap_(n);
+  }
+
+  // SECTION : element access
+  reference operator[](size_type n) FT_NOEXCEPT_ { return data()[n]; }
+
+  const_reference operator[](size_type n) const FT_NOEXCEPT_ {
+    return data()[n];
+  }
+
+  reference at(size_type n) {
+    if (n >= size())
+      throw std::out_of_range("exceeds the mapped_vector's size");
+    return (*this)[n];
+  }
+
+  const_reference at(size_type n) const {
+    if (n >= size())
+      throw std::out_of_range("exceeds the mapped_vector's size");
+    return (*this)[n];
+  }
+
+  reference front(void) FT_NOEXCEPT_ { return *begin(); }
+
+  const_reference front(void) const FT_NOEXCEPT_ { return *begin(); }
+
+  reference back(void) FT_NOEXCEPT_ { return *(end() - 1); }
+
+  const_reference back(void) const FT_NOEXCEPT_ { return *(end() - 1); }
+
+  pointer data(void) FT_NOEXCEPT_ { return is_open() ? Data_() : NULL; }
+
+  const_pointer data(void) const FT_NOEXCEPT_ {
+    return is_open() ? Data_() : NULL;
+  }
+
+  // SECTION : modifiers
+  // fill
+  void assign(size_type n, const value_type& val) {
+    const value_type val_copy(val);
+    clear();
+    resize(n, val_copy);
+  }
+
+  // range
+  template <typename InputIterator>
+  void assign(InputIterator first,
+              typename enable_if<is_input_iterator<InputIterator>::value,
+                                 InputIterator>::type last) {
+    clear();
+    for (; first != last; ++first) push_back(*first);
+  }
+
+  void push_back(const value_type& val) {
+    const size_type n = size();
+    if (n == capacity()) {
+      // val may live in the mapping which is about to move
+      const value_type val_copy(val);
+      reserve(NextCapacity_(n + 1));
+      new (static_cast<void*>(Data_() + n)) value_type(val_copy);
+    } else
+      new (static_cast<void*>(Data_() + n)) value_type(val);
+    Header_()->size = n + 1;
+  }
+
+  void pop_back(void) FT_NOEXCEPT_ { --Header_()->size; }
+
+  // range
+  iterator erase(iterator first, iterator last) {
+    std::copy(last, end(), first);
+    Header_()->size -= last - first;
+    return first;
+  }
+
+  // single element
+  iterator erase(iterator position) { return erase(position, position + 1); }
+
+  void swap(mapped_vector& x) FT_NOEXCEPT_ {
+    std::swap(fd_, x.fd_);
+    std::swap(map_, x.map_);
+    std::swap(map_size_, x.map_size_);
+  }
+
+  // the file keeps its capacity
+  void clear(void) FT_NOEXCEPT_ {
+    if (is_open()) Header_()->size = 0;
+  }
+};
+
+template <typename T>
+const typename mapped_vector<T>::size_type mapped_vector<T>::header_size;
+
+// SECTION : non-member function overloads (swap)
+template <typename T>
+inline void swap(mapped_vector<T>& x, mapped_vector<T>& y) FT_NOEXCEPT_ {
+  x.swap(y);
+}
+
+}  // namespace ft
+
+#endif
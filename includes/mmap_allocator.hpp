@@ -0,0 +1,143 @@
+/**
+ * @file mmap_allocator.hpp
+ * @author ghan (ghan@student.42seoul.kr)
+ * @brief An allocator backing large blocks with anonymous memory mappings
+ * @date 2022-07-02
+ */
+
+#ifndef FT_CONTAINERS_INCLUDES_MMAP_ALLOCATOR_HPP_
+#define FT_CONTAINERS_INCLUDES_MMAP_ALLOCATOR_HPP_
+
+#define FT_NOEXCEPT_ throw()
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <new>
+
+#include "type_traits.hpp"
+
+namespace ft {
+// Blocks of at least Threshold bytes are anonymous private mappings, smaller
+// ones come from operator new. A mapped block can be resized with
+// reallocate() : on Linux mremap moves the pages instead of copying them, so
+// growing a vector of N bytes needs about N bytes instead of 3N.
+// NOTE : reallocate() moves elements as raw bytes, it is only used by
+// containers for trivially copyable types
+template <typename T, size_t Threshold = (1 << 20)>
+class mmap_allocator {
+ public:
+  typedef T value_type;
+  typedef T* pointer;
+  typedef const T* const_pointer;
+  typedef T& reference;
+  typedef const T& const_reference;
+  typedef size_t size_type;
+  typedef ptrdiff_t difference_type;
+
+  template <typename U>
+  struct rebind {
+    typedef mmap_allocator<U, Threshold> other;
+  };
+
+  // Constructors (stateless)
+  mmap_allocator(void) FT_NOEXCEPT_ {}
+
+  mmap_allocator(const mmap_allocator&) FT_NOEXCEPT_ {}
+
+  template <typename U>
+  mmap_allocator(const mmap_allocator<U, Threshold>&) FT_NOEXCEPT_ {}
+
+  // Destructor
+  ~mmap_allocator(void) {}
+
+  pointer address(reference x) const { return &x; }
+
+  const_pointer address(const_reference x) const { return &x; }
+
+  pointer allocate(size_type n, const void* = 0) {
+    if (n > max_size()) throw std::bad_alloc();
+    const size_type bytes = n * sizeof(T);
+    if (!IsMapped_(bytes)) return static_cast<pointer>(::operator new(bytes));
+    void* ptr = mmap(NULL, PageRound_(bytes), PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (ptr == MAP_FAILED) throw std::bad_alloc();
+    return static_cast<pointer>(ptr);
+  }
+
+  void deallocate(pointer ptr, size_type n) {
+    if (ptr == NULL) return;
+    const size_type bytes = n * sizeof(T);
+    if (IsMapped_(bytes))
+      munmap(static_cast<void*>(ptr), PageRound_(bytes));
+    else
+      ::operator delete(static_cast<void*>(ptr));
+  }
+
+  // resize the block ptr of old_n elements to new_n elements, the first
+  // min(old_n, new_n) elements are carried over as raw bytes
+  pointer reallocate(pointer ptr, size_type old_n, size_type new_n) {
+    if (new_n > max_size()) throw std::bad_alloc();
+    const size_type old_bytes = old_n * sizeof(T);
+    const size_type new_bytes = new_n * sizeof(T);
+    if (ptr != NULL && IsMapped_(old_bytes) && IsMapped_(new_bytes)) {
+      if (PageRound_(old_bytes) == PageRound_(new_bytes)) return ptr;
+#if defined(__linux__) && defined(MREMAP_MAYMOVE)
+      void* moved = mremap(static_cast<void*>(ptr), PageRound_(old_bytes),
+                           PageRound_(new_bytes), MREMAP_MAYMOVE);
+      if (moved == MAP_FAILED) throw std::bad_alloc();
+      return static_cast<pointer>(moved);
+#endif
+    }
+    pointer new_ptr = allocate(new_n);
+    if (ptr != NULL)
+      std::memcpy(static_cast<void*>(new_ptr), static_cast<const void*>(ptr),
+                  (old_bytes < new_bytes) ? old_bytes : new_bytes);
+    deallocate(ptr, old_n);
+    return new_ptr;
+  }
+
+  size_type max_size(void) const FT_NOEXCEPT_ {
+    return (std::numeric_limits<size_type>::max() - PageSize_()) / sizeof(T);
+  }
+
+  void construct(pointer ptr, const_reference val) {
+    new (static_cast<void*>(ptr)) T(val);
+  }
+
+  void destroy(pointer ptr) { ptr->~T(); }
+
+ private:
+  static bool IsMapped_(size_type bytes) { return bytes >= Threshold; }
+
+  static size_type PageSize_(void) {
+    static const size_type page_size = sysconf(_SC_PAGESIZE);
+    return page_size;
+  }
+
+  static size_type PageRound_(size_type bytes) {
+    return (bytes + PageSize_() - 1) / PageSize_() * PageSize_();
+  }
+};
+
+template <typename T, typename U, size_t Threshold>
+inline bool operator==(const mmap_allocator<T, Threshold>&,
+                       const mmap_allocator<U, Threshold>&) {
+  return true;
+}
+
+template <typename T, typename U, size_t Threshold>
+inline bool operator!=(const mmap_allocator<T, Threshold>&,
+                       const mmap_allocator<U, Threshold>&) {
+  return false;
+}
+
+template <typename T, size_t Threshold>
+struct is_reallocating_allocator<mmap_allocator<T, Threshold> >
+    : public true_type {};
+}  // namespace ft
+
+#endif
@@ -0,0 +1,169 @@
+/**
+ * @file parallel.hpp
+ * @author ghan (ghan@student.42seoul.kr)
+ * @brief Opt-in multi-threaded fill, copy and destruction of large ranges
+ * @date 2022-07-08
+ */
+
+#ifndef FT_CONTAINERS_INCLUDES_PARALLEL_HPP_
+#define FT_CONTAINERS_INCLUDES_PARALLEL_HPP_
+
+#define FT_NOEXCEPT_ throw()
+
+#include <pthread.h>
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+
+namespace ft {
+
+// SECTION : configuration
+// Ranges of at least `threshold` elements are split across `threads` threads
+// (the calling one included). threads == 1, the default, turns it off.
+struct parallel_config {
+  size_t threads;
+  size_t threshold;
+};
+
+inline parallel_config& parallel_settings(void) FT_NOEXCEPT_ {
+  static parallel_config config = {1, 1 << 15};
+  return config;
+}
+
+inline void set_parallel_execution(size_t threads,
+                                   size_t threshold = 1 << 15) FT_NOEXCEPT_ {
+  parallel_settings().threads = (threads == 0) ? 1 : threads;
+  parallel_settings().threshold = threshold;
+}
+
+inline bool UseParallel_(size_t n) FT_NOEXCEPT_ {
+  const parallel_config& config = parallel_settings();
+  return config.threads > 1 && n >= config.threshold && n >= config.threads;
+}
+
+// SECTION : worker threads
+// Job is called as job(first, last) on disjoint index ranges of [0, n). It
+// must not throw : callers only hand over trivially copyable constructions
+// and destructions.
+template <typename Job>
+struct ParallelChunk_ {
+  const Job* job;
+  size_t first;
+  size_t last;
+};
+
+template <typename Job>
+void* RunParallelChunk_(void* arg) {
+  ParallelChunk_<Job>* chunk = static_cast<ParallelChunk_<Job>*>(arg);
+  (*chunk->job)(chunk->first, chunk->last);
+  return NULL;
+}
+
+// one chunk per thread, the calling thread takes the first one, and the ones
+// whose thread cannot be started
+template <typename Job>
+void ParallelFor_(size_t n, const Job& job) {
+  const size_t max_threads = 64;
+  size_t threads = parallel_settings().threads;
+  if (threads > max_threads) threads = max_threads;
+
+  pthread_t tids[max_threads];
+  bool started[max_threads];
+  ParallelChunk_<Job> chunks[max_threads];
+  const size_t chunk_size = n / threads;
+  for (size_t i = 0; i < threads; ++i) {
+    chunks[i].job = &job;
+    chunks[i].first = i * chunk_size;
+    chunks[i].last = (i + 1 == threads) ? n : (i + 1) * chunk_size;
+    started[i] = false;
+  }
+  for (size_t i = 1; i < threads; ++i)
+    started[i] = (pthread_create(&tids[i], NULL, RunParallelChunk_<Job>,
+                                 &chunks[i]) == 0);
+  for (size_t i = 0; i < threads; ++i)
+    if (!started[i]) RunParallelChunk_<Job>(&chunks[i]);
+  for (size_t i = 1; i < threads; ++i)
+    if (started[i]) pthread_join(tids[i], NULL);
+}
+
+// SECTION : jobs
+template <typename T>
+struct ParallelCopyJob_ {
+  const T* src;
+  T* dest;
+
+  void operator()(size_t first, size_t last) const {
+    std::memcpy(static_cast<void*>(dest + first),
+                static_cast<const void*>(src + first),
+                (last - first) * sizeof(T));
+  }
+};
+
+template <typename T>
+struct ParallelFillJob_ {
+  T* dest;
+  const T* val;
+
+  void operator()(size_t first, size_t last) const {
+    std::uninitialized_fill(dest + first, dest + last, *val);
+  }
+};
+
+template <typename T, typename Alloc>
+struct ParallelDestroyJob_ {
+  T* begin;
+  Alloc* alloc;
+
+  void operator()(size_t first, size_t last) const {
+    for (; first != last; ++first) alloc->destroy(begin + first);
+  }
+};
+
+// SECTION : range operations
+// each one falls back to the plain loop below the threshold
+
+// copy n trivially copyable elements into raw storage
+template <typename T>
+void ParallelCopy_(const T* src, size_t n, T* dest) {
+  if (n == 0) return;
+  if (!UseParallel_(n)) {
+    std::memcpy(static_cast<void*>(dest), static_cast<const void*>(src),
+                n * sizeof(T));
+    return;
+  }
+  ParallelCopyJob_<T> job;
+  job.src = src;
+  job.dest = dest;
+  ParallelFor_(n, job);
+}
+
+// construct n copies of a trivially copyable val in raw storage
+template <typename T>
+void ParallelFill_(T* dest, size_t n, const T& val) {
+  if (!UseParallel_(n)) {
+    std::uninitialized_fill_n(dest, n, val);
+    return;
+  }
+  ParallelFillJob_<T> job;
+  job.dest = dest;
+  job.val = &val;
+  ParallelFor_(n, job);
+}
+
+// destroy n elements through alloc
+template <typename T, typename Alloc>
+void ParallelDestroy_(T* first, size_t n, Alloc& alloc) {
+  if (!UseParallel_(n)) {
+    for (T* last = first + n; first != last; ++first) alloc.destroy(first);
+    return;
+  }
+  ParallelDestroyJob_<T, Alloc> job;
+  job.begin = first;
+  job.alloc = &alloc;
+  ParallelFor_(n, job);
+}
+
+}  // namespace ft
+
+#endif
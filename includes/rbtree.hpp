@@ -8,18 +8,15 @@
 #ifndef FT_CONTAINERS_INCLUDES_RBTREE_HPP
 #define FT_CONTAINERS_INCLUDES_RBTREE_HPP
 
-// #include <iostream>
+#include <algorithm>
 #include <functional>
+#include <iterator>
 #include <memory>
 
 #include "iterator_traits.hpp"
 #include "type_traits.hpp"
 #include "utility.hpp"
 
-#define R "\033[1;31m"
-#define B "\033[1;34m"
-#define RESET "\033[0m"
-
 #define FT_NOEXCEPT_ throw()
 
 namespace ft {
@@ -28,82 +25,272 @@ enum RbTreeColor { kBlack = true, kRed = false };
 
 enum RbTreeLeftOrRight { kLeft = 0, kRight };
 
-template <typename Key>
-struct RbTreeNode {
-  typedef Key KeyType;
-  typedef Key& KeyRef;
-  typedef RbTreeNode* pointer;
+// SECTION : nodes
+// The links and the color live in a key-less base, so that the tree's header
+// (see RbTree) is a node without a key. Leaves are NULL.
+struct RbTreeNodeBase {
+  typedef RbTreeNodeBase* BasePtr;
+
+  // the parent pointer, with the color in its lowest bit (nodes are at least
+  // pointer aligned, so the bit is always zero in the address)
+  enum { kColorBit = 1 };
 
-  RbTreeColor color;
-  pointer parent;
-  pointer left;
-  pointer right;
-  KeyType key;
-  pointer end;
-  bool is_nil;
+  size_t parent_and_color;
+  BasePtr left;
+  BasePtr right;
 
   // Constructor
-  RbTreeNode(const pointer nil_node = NULL, const bool is_nil_flag = false,
-             const RbTreeColor black_or_red = kRed,
-             const KeyType& key_value = KeyType(),
-             const pointer end_node = NULL)
-      : color(black_or_red),
-        parent(nil_node),
-        left(nil_node),
-        right(nil_node),
-        key(key_value),
-        end(end_node),
-        is_nil(is_nil_flag) {}
-
-  // find predecessor / successor of a node
-  pointer FindPredecessor(void) const {
-    const RbTreeNode* node = this;
-    if (!node->left->is_nil) return Max(node->left);
-    pointer p = node->parent;
-    while (!p->is_nil && node == p->left) {
+  RbTreeNodeBase(void) : parent_and_color(kRed), left(NULL), right(NULL) {}
+
+  // parent & color
+  BasePtr Parent(void) const {
+    return reinterpret_cast<BasePtr>(parent_and_color &
+                                     ~static_cast<size_t>(kColorBit));
+  }
+
+  void SetParent(BasePtr parent) {
+    parent_and_color =
+        reinterpret_cast<size_t>(parent) | (parent_and_color & kColorBit);
+  }
+
+  RbTreeColor Color(void) const {
+    return static_cast<RbTreeColor>(parent_and_color & kColorBit);
+  }
+
+  void SetColor(RbTreeColor color) {
+    parent_and_color = (parent_and_color & ~static_cast<size_t>(kColorBit)) |
+                       static_cast<size_t>(color);
+  }
+
+  // min & max of a non-empty subtree
+  static BasePtr Min(BasePtr node) {
+    while (node->left != NULL) node = node->left;
+    return node;
+  }
+
+  static BasePtr Max(BasePtr node) {
+    while (node->right != NULL) node = node->right;
+    return node;
+  }
+
+  // in-order successor / predecessor
+  // The header is end() : the successor of the max, and its predecessor is
+  // the max. It is the only red node whose grandparent is itself.
+  static BasePtr Increment(BasePtr node) {
+    if (node->right != NULL) return Min(node->right);
+    BasePtr p = node->Parent();
+    while (node == p->right) {
       node = p;
-      p = node->parent;
+      p = p->Parent();
     }
-    return p;
+    // node->right == p only when node is the header of a one node tree
+    return (node->right != p) ? p : node;
   }
 
-  pointer FindSuccessor(void) const {
-    const RbTreeNode* node = this;
-    if (node->is_nil) return node->end;
-    if (!node->right->is_nil) {
-      pointer ret = Min(node->right);
-      return (ret->is_nil) ? ret->end : ret;
-    };
-    pointer p = node->parent;
-    while (!p->is_nil && node == p->right) {
+  static BasePtr Decrement(BasePtr node) {
+    if (node->Color() == kRed && node->Parent()->Parent() == node)
+      return node->right;
+    if (node->left != NULL) return Max(node->left);
+    BasePtr p = node->Parent();
+    while (node == p->left) {
       node = p;
-      p = node->parent;
+      p = p->Parent();
     }
-    if (p->is_nil) return p->end;
     return p;
   }
+};
 
-  // min & max
-  static pointer Min(pointer node) {
-    while (!node->is_nil && !node->left->is_nil) node = node->left;
-    return node;
+// SECTION : augmentation
+// An augmentation policy picks the node base of the tree and keeps its extra
+// data up to date through static hooks, called by RbTree on element nodes
+// only (never on the header) :
+// - Init(node, n) : node is the root of a new subtree of n nodes
+// - Copy(dst, src) : dst takes src's place, or is a clone of src
+// - Rotated(node, new_top) : new_top was just rotated above node
+// - AddToPath(node, header, delta) : delta nodes were linked (or unlinked)
+//   below node, every node from node up to the root is updated
+// - RecountPath(node, header) : node got new children, it is recomputed from
+//   them, then every node up to the root
+// and the in-order links of a threaded tree through these, where the header
+// is both ends of the sequence :
+// - Thread(prev, next) : next comes right after prev
+// - LinkThread(node, parent, side) : node was just attached below parent
+// - UnlinkThread(node) : node is leaving the tree
+// - ThreadEnds(header) : the min & max of the header were just set
+// - ThreadAll(header) : the whole tree was just built
+// CountsNodes tells whether the root knows the size of the tree.
+// The node base's Increment & Decrement step the iterators.
+// Policies with extra queries (e.g. Count) only compile the RbTree members
+// which use them.
+
+// the default : plain nodes, every hook is a no-op
+struct no_order_statistics {
+  typedef RbTreeNodeBase NodeBase;
+  typedef RbTreeNodeBase* BasePtr;
+  typedef false_type CountsNodes;
+
+  static void Init(BasePtr, size_t) {}
+  static void Copy(BasePtr, BasePtr) {}
+  static void Rotated(BasePtr, BasePtr) {}
+  static void AddToPath(BasePtr, BasePtr, int) {}
+  static void RecountPath(BasePtr, BasePtr) {}
+
+  static void Thread(BasePtr, BasePtr) {}
+  static void LinkThread(BasePtr, BasePtr, RbTreeLeftOrRight) {}
+  static void UnlinkThread(BasePtr) {}
+  static void ThreadEnds(BasePtr) {}
+  static void ThreadAll(BasePtr) {}
+};
+
+// nodes which know the size of their subtree
+struct RbTreeCountedNodeBase : public RbTreeNodeBase {
+  size_t count;
+
+  RbTreeCountedNodeBase(void) : count(0) {}
+};
+
+// subtree sizes, for nth element & rank in O(log n)
+struct order_statistics {
+  typedef RbTreeCountedNodeBase NodeBase;
+  typedef RbTreeNodeBase* BasePtr;
+  typedef true_type CountsNodes;
+
+  static size_t Count(BasePtr node) {
+    return node == NULL ? 0 : static_cast<NodeBase*>(node)->count;
   }
 
-  static pointer Max(pointer node) {
-    while (!node->is_nil && !node->right->is_nil) node = node->right;
-    return node;
+  static void Init(BasePtr node, size_t n) {
+    static_cast<NodeBase*>(node)->count = n;
+  }
+
+  static void Copy(BasePtr dst, BasePtr src) { Init(dst, Count(src)); }
+
+  static void Rotated(BasePtr node, BasePtr new_top) {
+    Init(new_top, Count(node));
+    Init(node, Count(node->left) + Count(node->right) + 1);
   }
+
+  static void AddToPath(BasePtr node, BasePtr header, int delta) {
+    for (; node != header; node = node->Parent())
+      static_cast<NodeBase*>(node)->count += delta;
+  }
+
+  static void RecountPath(BasePtr node, BasePtr header) {
+    for (; node != header; node = node->Parent())
+      Init(node, Count(node->left) + Count(node->right) + 1);
+  }
+
+  static void Thread(BasePtr, BasePtr) {}
+  static void LinkThread(BasePtr, BasePtr, RbTreeLeftOrRight) {}
+  static void UnlinkThread(BasePtr) {}
+  static void ThreadEnds(BasePtr) {}
+  static void ThreadAll(BasePtr) {}
 };
 
+// nodes linked to their in-order neighbours : the header's next is the min
+// and its prev the max (itself when empty), so that an iterator steps with
+// one load instead of a walk through the tree
+struct RbTreeThreadedNodeBase : public RbTreeNodeBase {
+  BasePtr next;
+  BasePtr prev;
+
+  RbTreeThreadedNodeBase(void) : next(NULL), prev(NULL) {}
+
+  static BasePtr Increment(BasePtr node) {
+    return static_cast<RbTreeThreadedNodeBase*>(node)->next;
+  }
+
+  static BasePtr Decrement(BasePtr node) {
+    return static_cast<RbTreeThreadedNodeBase*>(node)->prev;
+  }
+};
+
+// in-order links, for O(1) iterator steps at two pointers per node
+struct threaded {
+  typedef RbTreeThreadedNodeBase NodeBase;
+  typedef RbTreeNodeBase* BasePtr;
+  typedef false_type CountsNodes;
+
+  static void Init(BasePtr, size_t) {}
+  static void Copy(BasePtr, BasePtr) {}
+  static void Rotated(BasePtr, BasePtr) {}
+  static void AddToPath(BasePtr, BasePtr, int) {}
+  static void RecountPath(BasePtr, BasePtr) {}
+
+  static void Thread(BasePtr prev, BasePtr next) {
+    static_cast<NodeBase*>(prev)->next = next;
+    static_cast<NodeBase*>(next)->prev = prev;
+  }
+
+  // a left child comes right before its parent, a right child right after
+  static void LinkThread(BasePtr node, BasePtr parent,
+                         RbTreeLeftOrRight side) {
+    if (side == kLeft) {
+      Thread(NodeBase::Decrement(parent), node);
+      Thread(node, parent);
+    } else {
+      Thread(node, NodeBase::Increment(parent));
+      Thread(parent, node);
+    }
+  }
+
+  static void UnlinkThread(BasePtr node) {
+    Thread(NodeBase::Decrement(node), NodeBase::Increment(node));
+  }
+
+  static void ThreadEnds(BasePtr header) {
+    Thread(header, header->left);
+    Thread(header->right, header);
+  }
+
+  static void ThreadAll(BasePtr header) {
+    BasePtr prev = header;
+    for (BasePtr node = header->left; node != header;
+         node = RbTreeNodeBase::Increment(node)) {
+      Thread(prev, node);
+      prev = node;
+    }
+    Thread(prev, header);
+  }
+};
+
+// NodeBase is RbTreeNodeBase, or the node base of an augmentation policy
+template <typename Value, typename NodeBase = RbTreeNodeBase>
+struct RbTreeNode : public NodeBase {
+  typedef Value ValueType;
+  typedef Value& ValueRef;
+  typedef RbTreeNode* pointer;
+
+  // constructed in place by RbTree, only the links are set up here
+  ValueType value;
+};
+
+// SECTION : key extractors
+// RbTree orders its elements by the part KeyOfValue gives, with Compare
 template <typename Value>
+struct RbTreeIdentity {
+  typedef Value KeyType;
+
+  const KeyType& operator()(const Value& value) const { return value; }
+};
+
+template <typename Pair>
+struct RbTreeSelectFirst {
+  typedef typename Pair::first_type KeyType;
+
+  const KeyType& operator()(const Pair& value) const { return value.first; }
+};
+
+template <typename Value, typename NodeBase = RbTreeNodeBase>
 class RbTreeIterator;
 
-template <typename Value>
+template <typename Value, typename NodeBase = RbTreeNodeBase>
 class RbTreeConstIterator {
  private:
-  typedef RbTreeNode<Value>* NodePtr_;
+  typedef RbTreeNodeBase* BasePtr_;
+  typedef RbTreeNode<Value, NodeBase>* NodePtr_;
 
-  NodePtr_ current_;
+  BasePtr_ current_;
 
  public:
   typedef bidirectional_iterator_tag iterator_category;
@@ -115,12 +302,12 @@ class RbTreeConstIterator {
   // Constructors
   RbTreeConstIterator(void) : current_() {}
 
-  RbTreeConstIterator(NodePtr_ itr) : current_(itr) {}
+  RbTreeConstIterator(BasePtr_ itr) : current_(itr) {}
 
   RbTreeConstIterator(const RbTreeConstIterator& original)
       : current_(original.current_) {}
 
-  RbTreeConstIterator(const RbTreeIterator<Value>& itr)
+  RbTreeConstIterator(const RbTreeIterator<Value, NodeBase>& itr)
       : current_(itr.base()) {}
 
   // Destructor
@@ -133,13 +320,17 @@ class RbTreeConstIterator {
   }
 
   // dereference & reference
-  reference operator*(void) const { return current_->key; }
+  reference operator*(void) const {
+    return static_cast<NodePtr_>(current_)->value;
+  }
 
-  pointer operator->(void) const { return &(current_->key); }
+  pointer operator->(void) const {
+    return &(static_cast<NodePtr_>(current_)->value);
+  }
 
   // increment & decrement
   RbTreeConstIterator& operator++(void) {
-    current_ = current_->FindSuccessor();
+    current_ = NodeBase::Increment(current_);
     return *this;
   }
 
@@ -150,7 +341,7 @@ class RbTreeConstIterator {
   }
 
   RbTreeConstIterator& operator--(void) {
-    current_ = current_->FindPredecessor();
+    current_ = NodeBase::Decrement(current_);
     return *this;
   }
 
@@ -160,39 +351,40 @@ class RbTreeConstIterator {
     return tmp;
   }
 
-  NodePtr_ base(void) const { return current_; }
+  BasePtr_ base(void) const { return current_; }
 };
 
-template <typename Value>
-bool operator==(const RbTreeConstIterator<Value>& lhs,
-                const RbTreeConstIterator<Value>& rhs) {
+template <typename Value, typename NodeBase>
+bool operator==(const RbTreeConstIterator<Value, NodeBase>& lhs,
+                const RbTreeConstIterator<Value, NodeBase>& rhs) {
   return lhs.base() == rhs.base();
 }
 
-template <typename Value>
-bool operator==(const RbTreeConstIterator<Value>& lhs,
-                const RbTreeIterator<Value>& rhs) {
+template <typename Value, typename NodeBase>
+bool operator==(const RbTreeConstIterator<Value, NodeBase>& lhs,
+                const RbTreeIterator<Value, NodeBase>& rhs) {
   return lhs.base() == rhs.base();
 }
 
-template <typename Value>
-bool operator!=(const RbTreeConstIterator<Value>& lhs,
-                const RbTreeConstIterator<Value>& rhs) {
+template <typename Value, typename NodeBase>
+bool operator!=(const RbTreeConstIterator<Value, NodeBase>& lhs,
+                const RbTreeConstIterator<Value, NodeBase>& rhs) {
   return lhs.base() != rhs.base();
 }
 
-template <typename Value>
-bool operator!=(const RbTreeConstIterator<Value>& lhs,
-                const RbTreeIterator<Value>& rhs) {
+template <typename Value, typename NodeBase>
+bool operator!=(const RbTreeConstIterator<Value, NodeBase>& lhs,
+                const RbTreeIterator<Value, NodeBase>& rhs) {
   return lhs.base() != rhs.base();
 }
 
-template <typename Value>
+template <typename Value, typename NodeBase>
 class RbTreeIterator {
  private:
-  typedef RbTreeNode<Value>* NodePtr_;
+  typedef RbTreeNodeBase* BasePtr_;
+  typedef RbTreeNode<Value, NodeBase>* NodePtr_;
 
-  NodePtr_ current_;
+  BasePtr_ current_;
 
  public:
   typedef bidirectional_iterator_tag iterator_category;
@@ -204,7 +396,7 @@ class RbTreeIterator {
   // Constructors
   RbTreeIterator(void) : current_() {}
 
-  RbTreeIterator(NodePtr_ itr) : current_(itr) {}
+  RbTreeIterator(BasePtr_ itr) : current_(itr) {}
 
   RbTreeIterator(const RbTreeIterator& original)
       : current_(original.current_) {}
@@ -219,13 +411,17 @@ class RbTreeIterator {
   }
 
   // dereference & reference
-  reference operator*(void) const { return current_->key; }
+  reference operator*(void) const {
+    return static_cast<NodePtr_>(current_)->value;
+  }
 
-  pointer operator->(void) const { return &(current_->key); }
+  pointer operator->(void) const {
+    return &(static_cast<NodePtr_>(current_)->value);
+  }
 
   // increment & decrement
   RbTreeIterator& operator++(void) {
-    current_ = current_->FindSuccessor();
+    current_ = NodeBase::Increment(current_);
     return *this;
   }
 
@@ -236,7 +432,7 @@ class RbTreeIterator {
   }
 
   RbTreeIterator& operator--(void) {
-    current_ = current_->FindPredecessor();
+    current_ = NodeBase::Decrement(current_);
     return *this;
   }
 
@@ -246,459 +442,1165 @@ class RbTreeIterator {
     return tmp;
   }
 
-  NodePtr_ base(void) const { return current_; }
+  BasePtr_ base(void) const { return current_; }
 };
 
-template <typename Value>
-bool operator==(const RbTreeIterator<Value>& lhs,
-                const RbTreeIterator<Value>& rhs) {
+template <typename Value, typename NodeBase>
+bool operator==(const RbTreeIterator<Value, NodeBase>& lhs,
+                const RbTreeIterator<Value, NodeBase>& rhs) {
   return lhs.base() == rhs.base();
 }
 
-template <typename Value>
-bool operator==(const RbTreeIterator<Value>& lhs,
-                const RbTreeConstIterator<Value>& rhs) {
+template <typename Value, typename NodeBase>
+bool operator==(const RbTreeIterator<Value, NodeBase>& lhs,
+                const RbTreeConstIterator<Value, NodeBase>& rhs) {
   return lhs.base() == rhs.base();
 }
 
-template <typename Value>
-bool operator!=(const RbTreeIterator<Value>& lhs,
-                const RbTreeIterator<Value>& rhs) {
+template <typename Value, typename NodeBase>
+bool operator!=(const RbTreeIterator<Value, NodeBase>& lhs,
+                const RbTreeIterator<Value, NodeBase>& rhs) {
   return lhs.base() != rhs.base();
 }
 
-template <typename Value>
-bool operator!=(const RbTreeIterator<Value>& lhs,
-                const RbTreeConstIterator<Value>& rhs) {
+template <typename Value, typename NodeBase>
+bool operator!=(const RbTreeIterator<Value, NodeBase>& lhs,
+                const RbTreeConstIterator<Value, NodeBase>& rhs) {
   return lhs.base() != rhs.base();
 }
 
+// SECTION : node pool
+// Nodes are carved out of slabs (arrays of nodes allocated at once), freed
+// nodes are kept in a free list for the next insertions. Slabs are only given
+// back all together, by Release (clear & destruction).
+// A tree split in two keeps nodes of both halves in the same slabs : those
+// slabs move to a group shared by both pools, and are freed with the last of
+// them. Groups which get joined are merged, the way union-find merges sets.
+template <typename Node, typename Alloc>
+class RbTreeNodePool {
+ private:
+  // a free node holds the next free node
+  struct FreeNode_ {
+    FreeNode_* next;
+  };
+
+  // the first node of every slab holds the previous slab and its size
+  struct SlabHeader_ {
+    Node* next;
+    size_t n_nodes;
+  };
+
+  // slabs shared by several pools
+  struct SharedSlabs_ {
+    Node* slabs;
+    SharedSlabs_* parent;  // the group it was merged into, which has the slabs
+    size_t n_owners;       // pools & merged groups pointing to it
+  };
+
+  typedef typename Alloc::template rebind<SharedSlabs_>::other AllocShared_;
+
+  Alloc alloc_;
+  Node* slabs_;           // most recent slab
+  Node* cursor_;          // next never used node of the most recent slab
+  Node* slab_end_;
+  FreeNode_* free_list_;
+  FreeNode_* free_tail_;  // valid while free_list_ is not NULL
+  size_t n_free_;         // nodes in the free list
+  size_t n_slab_nodes_;   // nodes in all the slabs
+  SharedSlabs_* shared_;  // NULL unless the tree was split
+
+  // non-copyable : every tree owns its pool
+  RbTreeNodePool(const RbTreeNodePool&);
+  RbTreeNodePool& operator=(const RbTreeNodePool&);
+
+  static SlabHeader_* Header_(Node* slab) {
+    return reinterpret_cast<SlabHeader_*>(slab);
+  }
+
+  void PushFree_(Node* node) {
+    FreeNode_* free_node = reinterpret_cast<FreeNode_*>(node);
+    if (free_list_ == NULL) free_tail_ = free_node;
+    free_node->next = free_list_;
+    free_list_ = free_node;
+    ++n_free_;
+  }
+
+  // slabs double with the pool, from 4 up to 4096 nodes
+  size_t NextSlabSize_(void) const {
+    return std::min(std::max(n_slab_nodes_, static_cast<size_t>(4)),
+                    static_cast<size_t>(4096));
+  }
+
+  void AddSlab_(size_t n_nodes) {
+    Node* slab = alloc_.allocate(n_nodes + 1);
+    Header_(slab)->next = slabs_;
+    Header_(slab)->n_nodes = n_nodes;
+    slabs_ = slab;
+    for (; cursor_ != slab_end_; ++cursor_) PushFree_(cursor_);
+    cursor_ = slab + 1;
+    slab_end_ = cursor_ + n_nodes;
+    n_slab_nodes_ += n_nodes;
+  }
+
+  void FreeSlabs_(Node* slabs) {
+    while (slabs != NULL) {
+      Node* next = Header_(slabs)->next;
+      alloc_.deallocate(slabs, Header_(slabs)->n_nodes + 1);
+      slabs = next;
+    }
+  }
+
+  // puts the slab list slabs in front of *list
+  static void SpliceSlabs_(Node** list, Node* slabs) {
+    if (slabs == NULL) return;
+    Node* last = slabs;
+    while (Header_(last)->next != NULL) last = Header_(last)->next;
+    Header_(last)->next = *list;
+    *list = slabs;
+  }
+
+  static SharedSlabs_* Root_(SharedSlabs_* group) {
+    while (group->parent != NULL) group = group->parent;
+    return group;
+  }
+
+  // drops one reference to group, freeing what is no longer referred to
+  void Unshare_(SharedSlabs_* group) {
+    while (group != NULL && --group->n_owners == 0) {
+      SharedSlabs_* parent = group->parent;
+      FreeSlabs_(group->slabs);
+      AllocShared_(alloc_).deallocate(group, 1);
+      group = parent;
+    }
+  }
+
+  // forgets every slab & node, without freeing anything
+  void Reset_(void) {
+    slabs_ = NULL;
+    cursor_ = NULL;
+    slab_end_ = NULL;
+    free_list_ = NULL;
+    free_tail_ = NULL;
+    n_free_ = 0;
+    n_slab_nodes_ = 0;
+    shared_ = NULL;
+  }
+
+ public:
+  explicit RbTreeNodePool(const Alloc& alloc = Alloc())
+      : alloc_(alloc),
+        slabs_(NULL),
+        cursor_(NULL),
+        slab_end_(NULL),
+        free_list_(NULL),
+        free_tail_(NULL),
+        n_free_(0),
+        n_slab_nodes_(0),
+        shared_(NULL) {}
+
+  ~RbTreeNodePool(void) { Release(); }
+
+  // raw memory for one node
+  Node* Allocate(void) {
+    if (free_list_ != NULL) {
+      Node* node = reinterpret_cast<Node*>(free_list_);
+      free_list_ = free_list_->next;
+      --n_free_;
+      return node;
+    }
+    if (cursor_ == slab_end_) AddSlab_(NextSlabSize_());
+    return cursor_++;
+  }
+
+  // the node must have been destroyed
+  void Deallocate(Node* node) { PushFree_(node); }
+
+  // room for n more nodes without allocating
+  void Reserve(size_t n) {
+    const size_t available = n_free_ + (slab_end_ - cursor_);
+    if (n > available) AddSlab_(n - available);
+  }
+
+  // every node of the tree must have been destroyed, shared slabs are kept
+  // as long as another pool uses them
+  void Release(void) {
+    FreeSlabs_(slabs_);
+    Unshare_(shared_);
+    Reset_();
+  }
+
+  // after a split : x (released) gets nodes which live in this pool's slabs
+  void Share(RbTreeNodePool& x) {
+    if (shared_ == NULL) {
+      shared_ = AllocShared_(alloc_).allocate(1);
+      shared_->slabs = NULL;
+      shared_->parent = NULL;
+      shared_->n_owners = 1;
+    }
+    SpliceSlabs_(&Root_(shared_)->slabs, slabs_);
+    slabs_ = NULL;
+    x.shared_ = shared_;
+    ++shared_->n_owners;
+  }
+
+  // after a join : this pool takes over x's slabs, groups and free nodes,
+  // x is left empty (the unused end of its last slab is not reused)
+  void Merge(RbTreeNodePool& x) {
+    SpliceSlabs_(&slabs_, x.slabs_);
+    if (x.free_list_ != NULL) {
+      x.free_tail_->next = free_list_;
+      if (free_list_ == NULL) free_tail_ = x.free_tail_;
+      free_list_ = x.free_list_;
+      n_free_ += x.n_free_;
+    }
+    n_slab_nodes_ += x.n_slab_nodes_;
+    if (shared_ == NULL) {
+      shared_ = x.shared_;
+    } else if (x.shared_ != NULL) {
+      SharedSlabs_* root = Root_(shared_);
+      SharedSlabs_* x_root = Root_(x.shared_);
+      if (root != x_root) {
+        SpliceSlabs_(&root->slabs, x_root->slabs);
+        x_root->slabs = NULL;
+        x_root->parent = root;
+        ++root->n_owners;
+      }
+      Unshare_(x.shared_);
+    }
+    x.Reset_();
+  }
+
+  void Swap(RbTreeNodePool& x) {
+    std::swap(slabs_, x.slabs_);
+    std::swap(cursor_, x.cursor_);
+    std::swap(slab_end_, x.slab_end_);
+    std::swap(free_list_, x.free_list_);
+    std::swap(free_tail_, x.free_tail_);
+    std::swap(n_free_, x.n_free_);
+    std::swap(n_slab_nodes_, x.n_slab_nodes_);
+    std::swap(shared_, x.shared_);
+  }
+};
+
+
 // SECTION : Red-Black Tree
-template <typename Key, typename Compare = std::less<Key>,
-          typename Alloc = std::allocator<Key> >
+// header_ is stored in the tree itself and acts as end() : its parent is the
+// root, its left the min and its right the max (itself when empty), and the
+// root's parent is the header. An empty tree owns no memory at all.
+// Lookups take any key type Compare accepts against KeyType, the owner
+// decides which ones to expose.
+template <typename Value, typename KeyOfValue, typename Compare,
+          typename Alloc = std::allocator<Value>,
+          typename Augment = no_order_statistics>
 class RbTree {
  public:
   typedef Alloc AllocType;
-  typedef Key KeyType;
-  typedef Key* KeyPtr;
-  typedef Key& KeyRef;
-  typedef RbTreeNode<KeyType> Node;
+  typedef Value ValueType;
+  typedef Value* ValuePtr;
+  typedef Value& ValueRef;
+  typedef typename KeyOfValue::KeyType KeyType;
+  typedef typename Augment::NodeBase NodeBase;
+  typedef RbTreeNode<ValueType, NodeBase> Node;
   typedef Node* NodePtr;
+  typedef RbTreeNodeBase* BasePtr;
   typedef typename AllocType::template rebind<Node>::other AllocNodeType;
   typedef typename AllocNodeType::const_pointer ConstNodePtr;
-  typedef RbTreeIterator<KeyType> iterator;
-  typedef RbTreeConstIterator<KeyType> const_iterator;
+  typedef RbTreeIterator<ValueType, NodeBase> iterator;
+  typedef RbTreeConstIterator<ValueType, NodeBase> const_iterator;
   typedef reverse_iterator<const_iterator> const_reverse_iterator;
   typedef reverse_iterator<iterator> reverse_iterator;
   typedef size_t size_type;
 
  private:
-  struct RbTreeImpl_ {
-    AllocNodeType alloc_;
-    NodePtr nil;
-    NodePtr end;
-    NodePtr min;
-    NodePtr max;
-
-    // Default constructor
-    explicit RbTreeImpl_(const AllocNodeType& alloc = AllocNodeType())
-        : alloc_(alloc), min(NULL), max(NULL) {
-      try {
-        nil = alloc_.allocate(1);
-        alloc_.construct(nil, Node(NULL, true, kBlack));
-        nil->parent = nil;
-        nil->left = nil;
-        nil->right = nil;
-        end = alloc_.allocate(1);
-        alloc_.construct(end, Node(nil));
-        nil->end = end;
-      } catch (const std::exception& e) {
-        alloc_.destroy(nil);
-        alloc_.deallocate(nil, 1);
-        throw e;
-      }
-    }
-
-    RbTreeImpl_(const RbTreeImpl_& original)
-        : alloc_(original.alloc_),
-          nil(original.nil),
-          end(original.end),
-          min(original.min),
-          max(original.max) {}
-
-    RbTreeImpl_& operator=(const RbTreeImpl_& rhs) {
-      nil = rhs.nil;
-      end = rhs.end;
-      min = rhs.min;
-      max = rhs.max;
-      return *this;
-    }
-
-    // Destructor
-    ~RbTreeImpl_(void) {}
-  };
-
-  RbTreeImpl_ impl_;
-  NodePtr root_;
+  NodeBase header_;
   Compare comp_;
-  AllocNodeType alloc_;
+  AllocType alloc_;  // constructs the values in the nodes
   size_type size_;
+  RbTreeNodePool<Node, AllocNodeType> pool_;  // element nodes
 
  public:
   // Constructors
-  RbTree(const Compare& comp = Compare(),
-         const AllocType& alloc = AllocNodeType())
-      : impl_(RbTreeImpl_(alloc)),
-        root_(impl_.nil),
-        comp_(comp),
-        alloc_(alloc),
-        size_(0) {
-    impl_.end->parent = root_;
-    impl_.min = root_;
-    impl_.max = root_;
+  RbTree(const Compare& comp = Compare(), const AllocType& alloc = AllocType())
+      : comp_(comp), alloc_(alloc), size_(0), pool_(alloc) {
+    ResetHeader_();
   }
 
   // Copy constructor (Deep copy)
   RbTree(const RbTree& original)
-      : impl_(RbTreeImpl_(original.alloc_)),
-        root_(impl_.nil),
-        comp_(original.comp_),
+      : comp_(original.comp_),
         alloc_(original.alloc_),
-        size_(0) {
-    const_iterator itr = original.begin();
-    const_iterator itre = original.end();
-    for (; itr != itre; ++itr) Insert(*itr);
+        size_(0),
+        pool_(original.alloc_) {
+    ResetHeader_();
+    CopyFrom_(original);
   }
 
+  // the current nodes go back to the pool and are reused by the copy
   RbTree& operator=(const RbTree& rhs) {
-    ClearPostOrder(root_);
-    impl_ = RbTreeImpl_(rhs.alloc_);
-    root_ = impl_.nil;
-    comp_ = rhs.comp_;
-    alloc_ = rhs.alloc_;
+    if (this == &rhs) return *this;
+    ClearPostOrder_(Root_());
+    ResetHeader_();
     size_ = 0;
-    const_iterator itr = rhs.begin();
-    const_iterator itre = rhs.end();
-    for (; itr != itre; ++itr) Insert(*itr);
+    comp_ = rhs.comp_;
+    CopyFrom_(rhs);
     return *this;
   }
 
   // Destructor
-  ~RbTree(void) {
-    ClearPostOrder(root_);
-    FreeResource_(impl_.nil);
-    if (impl_.nil != impl_.end) FreeResource_(impl_.end);
-  }
+  ~RbTree(void) { Clear(); }
 
  private:
+  // SECTION : header & node utils
+  void ResetHeader_(void) {
+    header_.parent_and_color = kRed;
+    header_.left = &header_;
+    header_.right = &header_;
+    Augment::ThreadEnds(&header_);
+  }
+
+  BasePtr Root_(void) const { return header_.Parent(); }
+
+  void SetRoot_(BasePtr root) { header_.SetParent(root); }
+
+  BasePtr End_(void) const { return const_cast<NodeBase*>(&header_); }
+
+  static const ValueType& Value_(BasePtr node) {
+    return static_cast<NodePtr>(node)->value;
+  }
+
+  static const KeyType& KeyOf_(const ValueType& value) {
+    return KeyOfValue()(value);
+  }
+
+  static const KeyType& Key_(BasePtr node) { return KeyOf_(Value_(node)); }
+
+  // element makers : make(alloc, ptr) constructs an element at ptr, so that a
+  // node is only filled once its key is known to be missing
+  struct CopyValue_ {
+    const ValueType& value;
+
+    explicit CopyValue_(const ValueType& v) : value(v) {}
+
+    void operator()(AllocType& alloc, ValuePtr ptr) const {
+      alloc.construct(ptr, value);
+    }
+  };
+
+  // a red leaf whose value is constructed by make(alloc_, &node->value)
+  template <typename Maker>
+  NodePtr CreateNodeWith_(const Maker& make) {
+    NodePtr node = pool_.Allocate();
+    try {
+      make(alloc_, &node->value);
+    } catch (...) {
+      pool_.Deallocate(node);
+      throw;
+    }
+    node->parent_and_color = kRed;
+    node->left = NULL;
+    node->right = NULL;
+    return node;
+  }
+
+  // a red leaf holding a copy of value
+  NodePtr CreateNode_(const ValueType& value) {
+    return CreateNodeWith_(CopyValue_(value));
+  }
+
+  // element nodes go back to the pool
+  void FreeNode_(BasePtr node) {
+    alloc_.destroy(&static_cast<NodePtr>(node)->value);
+    pool_.Deallocate(static_cast<NodePtr>(node));
+  }
+
   // Rotations
-  void LeftRotate_(NodePtr node) {
-    NodePtr right_child = node->right;
+  void LeftRotate_(BasePtr node) {
+    BasePtr right_child = node->right;
     node->right = right_child->left;
-    if (right_child->left != impl_.nil) right_child->left->parent = node;
-    right_child->parent = node->parent;
-    if (node->parent == impl_.nil)
-      root_ = right_child;
-    else if (node == node->parent->left)
-      node->parent->left = right_child;
+    if (right_child->left != NULL) right_child->left->SetParent(node);
+    right_child->SetParent(node->Parent());
+    if (node == Root_())
+      SetRoot_(right_child);
+    else if (node == node->Parent()->left)
+      node->Parent()->left = right_child;
     else
-      node->parent->right = right_child;
+      node->Parent()->right = right_child;
     right_child->left = node;
-    node->parent = right_child;
+    node->SetParent(right_child);
+    Augment::Rotated(node, right_child);
   }
 
-  void RightRotate_(NodePtr node) {
-    NodePtr left_child = node->left;
+  void RightRotate_(BasePtr node) {
+    BasePtr left_child = node->left;
     node->left = left_child->right;
-    if (left_child->right != impl_.nil) left_child->right->parent = node;
-    left_child->parent = node->parent;
-    if (node->parent == impl_.nil)
-      root_ = left_child;
-    else if (node == node->parent->right)
-      node->parent->right = left_child;
+    if (left_child->right != NULL) left_child->right->SetParent(node);
+    left_child->SetParent(node->Parent());
+    if (node == Root_())
+      SetRoot_(left_child);
+    else if (node == node->Parent()->right)
+      node->Parent()->right = left_child;
     else
-      node->parent->left = left_child;
+      node->Parent()->left = left_child;
     left_child->right = node;
-    node->parent = left_child;
+    node->SetParent(left_child);
+    Augment::Rotated(node, left_child);
+  }
+
+  static bool IsBlack_(BasePtr node) {
+    return node == NULL || node->Color() == kBlack;
   }
 
   // SECTION : insert utils
   // Roate or recolor nodes to keep RB-properties
-  NodePtr RecolorRedUncleInsert_(NodePtr node, NodePtr uncle) {
-    node->parent->color = kBlack;
-    uncle->color = kBlack;
-    node->parent->parent->color = kRed;
-    return node->parent->parent;
-  }
-
-  void AdjustAfterInsert_(NodePtr node) {
-    NodePtr uncle = impl_.nil;
-    while (node->parent->color == kRed) {
-      if (node->parent == node->parent->parent->left) {
-        uncle = node->parent->parent->right;
-        if (uncle->color == kRed)
+  BasePtr RecolorRedUncleInsert_(BasePtr node, BasePtr uncle) {
+    node->Parent()->SetColor(kBlack);
+    uncle->SetColor(kBlack);
+    node->Parent()->Parent()->SetColor(kRed);
+    return node->Parent()->Parent();
+  }
+
+  // returns whether the root had to be turned black, i.e. whether the black
+  // height of the tree grew
+  bool AdjustAfterInsert_(BasePtr node) {
+    BasePtr uncle = NULL;
+    while (node != Root_() && node->Parent()->Color() == kRed) {
+      if (node->Parent() == node->Parent()->Parent()->left) {
+        uncle = node->Parent()->Parent()->right;
+        if (!IsBlack_(uncle))
           node = RecolorRedUncleInsert_(node, uncle);
         else {
-          if (node == node->parent->right) {
-            node = node->parent;
+          if (node == node->Parent()->right) {
+            node = node->Parent();
             LeftRotate_(node);
           }
-          node->parent->color = kBlack;
-          node->parent->parent->color = kRed;
-          RightRotate_(node->parent->parent);
+          node->Parent()->SetColor(kBlack);
+          node->Parent()->Parent()->SetColor(kRed);
+          RightRotate_(node->Parent()->Parent());
         }
       } else {
-        uncle = node->parent->parent->left;
-        if (uncle->color == kRed)
+        uncle = node->Parent()->Parent()->left;
+        if (!IsBlack_(uncle))
           node = RecolorRedUncleInsert_(node, uncle);
         else {
-          if (node == node->parent->left) {
-            node = node->parent;
+          if (node == node->Parent()->left) {
+            node = node->Parent();
             RightRotate_(node);
           }
-          node->parent->color = kBlack;
-          node->parent->parent->color = kRed;
-          LeftRotate_(node->parent->parent);
+          node->Parent()->SetColor(kBlack);
+          node->Parent()->Parent()->SetColor(kRed);
+          LeftRotate_(node->Parent()->Parent());
         }
       }
     }
-    root_->color = kBlack;
+    const bool grew = (Root_()->Color() == kRed);
+    Root_()->SetColor(kBlack);
+    return grew;
   }
 
-  // SECTION : delete utils
-  template <typename T>
-  void FreeResource_(T* ptr) {
-    alloc_.destroy(ptr);
-    alloc_.deallocate(ptr, 1);
-  }
-
-  void DeleteLastNode_(void) {
-    FreeResource_(root_);
-    FreeResource_(impl_.end);
-    root_ = impl_.nil;
-    impl_.end = impl_.nil;
-    impl_.min = impl_.nil;
-    impl_.max = impl_.nil;
-    impl_.nil->end = impl_.nil;
-    --size_;
+  // a new node holding a copy of value, linked by LinkAt_
+  iterator InsertAt_(BasePtr parent, RbTreeLeftOrRight side,
+                     const ValueType& value) {
+    return LinkAt_(parent, side, CreateNode_(value));
   }
 
-  void Transplant_(NodePtr original, NodePtr replacement) {
-    if (!comp_(impl_.min->key, original->key) &&
-        !comp_(original->key, impl_.min->key))
-      impl_.min = original->parent;
-    else if (!comp_(impl_.max->key, original->key) &&
-             !comp_(original->key, impl_.max->key)) {
-      impl_.max = original->parent;
-      impl_.end->parent = impl_.max;
+  // links a new node as the given child of parent (the header if the tree is
+  // empty), keeps min & max up to date and rebalances
+  iterator LinkAt_(BasePtr parent, RbTreeLeftOrRight side, BasePtr node) {
+    node->SetParent(parent);
+    Augment::Init(node, 1);
+    Augment::AddToPath(parent, &header_, 1);
+    if (parent == &header_) {
+      SetRoot_(node);
+      header_.left = node;
+      header_.right = node;
+    } else if (side == kLeft) {
+      parent->left = node;
+      if (parent == header_.left) header_.left = node;
+    } else {
+      parent->right = node;
+      if (parent == header_.right) header_.right = node;
     }
-    if (original->parent == impl_.nil)
-      root_ = replacement;
-    else if (original == original->parent->left)
-      original->parent->left = replacement;
-    else
-      original->parent->right = replacement;
-    replacement->parent = original->parent;
-  }
-
-  void AdjustAfterDelete_(NodePtr node) {
-    NodePtr sibling = impl_.nil;
-    while (node != root_ && node->color == kBlack) {
-      if (node == node->parent->left) {
-        sibling = node->parent->right;
-        if (sibling->color == kRed) {
-          sibling->color = kBlack;
-          node->parent->color = kRed;
-          LeftRotate_(node->parent);
-          sibling = node->parent->right;
+    Augment::LinkThread(node, parent, side);
+    AdjustAfterInsert_(node);
+    ++size_;
+    return iterator(node);
+  }
+
+  // a new node made by make, linked by LinkAt_
+  template <typename Maker>
+  iterator EmplaceAt_(BasePtr parent, RbTreeLeftOrRight side,
+                      const Maker& make) {
+    return LinkAt_(parent, side, CreateNodeWith_(make));
+  }
+
+  // unique insertion by key, the element is only made on a miss
+  template <typename Maker>
+  pair<iterator, bool> InsertUnique_(const KeyType& key, const Maker& make) {
+    BasePtr parent = &header_;
+    BasePtr cursor = Root_();
+    bool went_left = true;
+    while (cursor != NULL) {
+      parent = cursor;
+      went_left = comp_(key, Key_(cursor));
+      cursor = went_left ? cursor->left : cursor->right;
+    }
+    // the only candidate for an equal key is the predecessor of the slot
+    iterator prev(parent);
+    if (went_left) {
+      if (parent == header_.left)
+        return ft::make_pair(EmplaceAt_(parent, kLeft, make), true);
+      --prev;
+    }
+    if (comp_(Key_(prev.base()), key))
+      return ft::make_pair(
+          EmplaceAt_(parent, went_left ? kLeft : kRight, make), true);
+    return ft::make_pair(prev, false);
+  }
+
+  template <typename Maker>
+  pair<iterator, bool> InsertUnique_(const KeyType& key, const Maker& make,
+                                     BasePtr hint) {
+    if (hint == &header_) {
+      if (size_ != 0 && comp_(Key_(header_.right), key))
+        return ft::make_pair(EmplaceAt_(header_.right, kRight, make), true);
+      return InsertUnique_(key, make);
+    }
+    if (comp_(key, Key_(hint))) {
+      // before the hint
+      if (hint == header_.left)
+        return ft::make_pair(EmplaceAt_(hint, kLeft, make), true);
+      BasePtr before = NodeBase::Decrement(hint);
+      if (!comp_(Key_(before), key)) return InsertUnique_(key, make);
+      if (before->right == NULL)
+        return ft::make_pair(EmplaceAt_(before, kRight, make), true);
+      return ft::make_pair(EmplaceAt_(hint, kLeft, make), true);
+    }
+    if (comp_(Key_(hint), key)) {
+      // after the hint
+      if (hint == header_.right)
+        return ft::make_pair(EmplaceAt_(hint, kRight, make), true);
+      BasePtr after = NodeBase::Increment(hint);
+      if (!comp_(key, Key_(after))) return InsertUnique_(key, make);
+      if (hint->right == NULL)
+        return ft::make_pair(EmplaceAt_(hint, kRight, make), true);
+      return ft::make_pair(EmplaceAt_(after, kLeft, make), true);
+    }
+    // equivalent to the hint
+    return ft::make_pair(iterator(hint), false);
+  }
+
+  // SECTION : delete utils
+  // Unlinks node and rebalances, x is the node which moved into the removed
+  // position (possibly NULL, hence x_parent)
+  void AdjustAfterDelete_(BasePtr x, BasePtr x_parent) {
+    BasePtr sibling = NULL;
+    while (x != Root_() && IsBlack_(x)) {
+      if (x == x_parent->left) {
+        sibling = x_parent->right;
+        if (sibling->Color() == kRed) {
+          sibling->SetColor(kBlack);
+          x_parent->SetColor(kRed);
+          LeftRotate_(x_parent);
+          sibling = x_parent->right;
         }
-        if (sibling->left->color == kBlack && sibling->right->color == kBlack) {
-          sibling->color = kRed;
-          node = node->parent;
+        if (IsBlack_(sibling->left) && IsBlack_(sibling->right)) {
+          sibling->SetColor(kRed);
+          x = x_parent;
+          x_parent = x_parent->Parent();
         } else {
-          if (sibling->right->color == kBlack) {
-            sibling->left->color = kBlack;
-            sibling->color = kRed;
+          if (IsBlack_(sibling->right)) {
+            sibling->left->SetColor(kBlack);
+            sibling->SetColor(kRed);
             RightRotate_(sibling);
-            sibling = node->parent->right;
+            sibling = x_parent->right;
           }
-          sibling->color = node->parent->color;
-          node->parent->color = kBlack;
-          sibling->right->color = kBlack;
-          LeftRotate_(node->parent);
-          node = root_;
+          sibling->SetColor(x_parent->Color());
+          x_parent->SetColor(kBlack);
+          if (sibling->right != NULL) sibling->right->SetColor(kBlack);
+          LeftRotate_(x_parent);
+          break;
         }
       } else {
-        if (node == node->parent->right) {
-          sibling = node->parent->left;
-          if (sibling->color == kRed) {
-            sibling->color = kBlack;
-            node->parent->color = kRed;
-            RightRotate_(node->parent);
-            sibling = node->parent->left;
-          }
-          if (sibling->right->color == kBlack &&
-              sibling->right->color == kBlack) {
-            sibling->color = kRed;
-            node = node->parent;
-          } else {
-            if (sibling->left->color == kBlack) {
-              sibling->right->color = kBlack;
-              sibling->color = kRed;
-              LeftRotate_(sibling);
-              sibling = node->parent->left;
-            }
-            sibling->color = node->parent->color;
-            node->parent->color = kBlack;
-            sibling->left->color = kBlack;
-            RightRotate_(node->parent);
-            node = root_;
+        sibling = x_parent->left;
+        if (sibling->Color() == kRed) {
+          sibling->SetColor(kBlack);
+          x_parent->SetColor(kRed);
+          RightRotate_(x_parent);
+          sibling = x_parent->left;
+        }
+        if (IsBlack_(sibling->right) && IsBlack_(sibling->left)) {
+          sibling->SetColor(kRed);
+          x = x_parent;
+          x_parent = x_parent->Parent();
+        } else {
+          if (IsBlack_(sibling->left)) {
+            sibling->right->SetColor(kBlack);
+            sibling->SetColor(kRed);
+            LeftRotate_(sibling);
+            sibling = x_parent->left;
           }
+          sibling->SetColor(x_parent->Color());
+          x_parent->SetColor(kBlack);
+          if (sibling->left != NULL) sibling->left->SetColor(kBlack);
+          RightRotate_(x_parent);
+          break;
         }
       }
     }
-    node->color = kBlack;
+    if (x != NULL) x->SetColor(kBlack);
+  }
+
+  // puts replacement (possibly NULL) in original's position
+  void Transplant_(BasePtr original, BasePtr replacement) {
+    if (original == Root_())
+      SetRoot_(replacement);
+    else if (original == original->Parent()->left)
+      original->Parent()->left = replacement;
+    else
+      original->Parent()->right = replacement;
+    if (replacement != NULL) replacement->SetParent(original->Parent());
+  }
+
+  // detaches node from the tree, keeping it balanced
+  void Unlink_(BasePtr node) {
+    BasePtr x = NULL;
+    BasePtr x_parent = NULL;
+    RbTreeColor original_color = node->Color();
+    Augment::UnlinkThread(node);
+    if (node == header_.left)
+      header_.left = (node->right != NULL) ? RbTreeNodeBase::Min(node->right)
+                                           : node->Parent();
+    if (node == header_.right)
+      header_.right = (node->left != NULL) ? RbTreeNodeBase::Max(node->left)
+                                           : node->Parent();
+    if (node->left == NULL || node->right == NULL) {
+      Augment::AddToPath(node->Parent(), &header_, -1);
+      x = (node->left == NULL) ? node->right : node->left;
+      x_parent = node->Parent();
+      Transplant_(node, x);
+    } else {
+      // y, node's successor, is the one leaving its position
+      BasePtr y = RbTreeNodeBase::Min(node->right);
+      Augment::AddToPath(y->Parent(), &header_, -1);
+      Augment::Copy(y, node);
+      original_color = y->Color();
+      x = y->right;
+      if (y->Parent() == node)
+        x_parent = y;
+      else {
+        x_parent = y->Parent();
+        Transplant_(y, x);
+        y->right = node->right;
+        y->right->SetParent(y);
+      }
+      Transplant_(node, y);
+      y->left = node->left;
+      y->left->SetParent(y);
+      y->SetColor(node->Color());
+    }
+    if (Root_() == NULL)
+      ResetHeader_();
+    else if (original_color == kBlack)
+      AdjustAfterDelete_(x, x_parent);
+  }
+
+  // SECTION : structural copy
+  // The source is already a valid red-black tree : its shape and colors are
+  // copied as they are, without any comparison or rebalancing, in O(n)
+  BasePtr CloneNode_(BasePtr src) {
+    BasePtr node = CreateNode_(Value_(src));
+    node->parent_and_color = src->Color();
+    Augment::Copy(node, src);
+    return node;
+  }
+
+  // recurses on the right children, loops down the left ones
+  BasePtr CloneSubtree_(BasePtr src, BasePtr parent) {
+    BasePtr top = CloneNode_(src);
+    top->SetParent(parent);
+    try {
+      if (src->right != NULL) top->right = CloneSubtree_(src->right, top);
+      parent = top;
+      for (src = src->left; src != NULL; src = src->left) {
+        BasePtr node = CloneNode_(src);
+        parent->left = node;
+        node->SetParent(parent);
+        if (src->right != NULL) node->right = CloneSubtree_(src->right, node);
+        parent = node;
+      }
+    } catch (...) {
+      ClearPostOrder_(top);
+      throw;
+    }
+    return top;
+  }
+
+  // this tree must be empty
+  void CopyFrom_(const RbTree& src) {
+    if (src.Root_() == NULL) return;
+    pool_.Reserve(src.size_);
+    SetRoot_(CloneSubtree_(src.Root_(), &header_));
+    header_.left = RbTreeNodeBase::Min(Root_());
+    header_.right = RbTreeNodeBase::Max(Root_());
+    Augment::ThreadAll(&header_);
+    size_ = src.size_;
+  }
+
+  // SECTION : bulk build
+  // A tree whose subtree sizes differ by at most one at every node has all
+  // its levels full but the deepest one. Coloring the deepest level red (if
+  // it is not full) and every other node black makes it a red-black tree.
+  static size_type RedDepth_(size_type n) {
+    size_type depth = 0;
+    while ((static_cast<size_type>(2) << depth) - 1 <= n) ++depth;
+    return depth;
+  }
+
+  // builds a subtree out of the next n keys of first, in order
+  template <typename InputIterator>
+  BasePtr BuildSubtree_(InputIterator& first, size_type n, size_type depth,
+                        size_type red_depth) {
+    if (n == 0) return NULL;
+    const size_type n_left = (n - 1) / 2;
+    BasePtr left = BuildSubtree_(first, n_left, depth + 1, red_depth);
+    BasePtr node = NULL;
+    try {
+      node = CreateNode_(*first);
+    } catch (...) {
+      ClearPostOrder_(left);
+      throw;
+    }
+    ++first;
+    node->parent_and_color = depth == red_depth ? kRed : kBlack;
+    Augment::Init(node, n);
+    node->left = left;
+    if (left != NULL) left->SetParent(node);
+    try {
+      node->right =
+          BuildSubtree_(first, n - n_left - 1, depth + 1, red_depth);
+    } catch (...) {
+      ClearPostOrder_(node);
+      throw;
+    }
+    if (node->right != NULL) node->right->SetParent(node);
+    return node;
+  }
+
+  // this tree must be empty, [first, first + n) sorted & unique
+  template <typename InputIterator>
+  void Build_(InputIterator first, size_type n) {
+    if (n == 0) return;
+    pool_.Reserve(n);
+    SetRoot_(BuildSubtree_(first, n, 0, RedDepth_(n)));
+    Root_()->SetParent(&header_);
+    header_.left = RbTreeNodeBase::Min(Root_());
+    header_.right = RbTreeNodeBase::Max(Root_());
+    Augment::ThreadAll(&header_);
+    size_ = n;
+  }
+
+  template <typename ForwardIterator>
+  bool IsSortedUnique_(ForwardIterator first, ForwardIterator last) const {
+    if (first == last) return true;
+    for (ForwardIterator next = first; ++next != last; first = next)
+      if (!comp_(KeyOf_(*first), KeyOf_(*next))) return false;
+    return true;
   }
 
- public:
   // SECTION : clear post-order
-  void ClearPostOrder(NodePtr node) {
-    if (node == impl_.nil) return;
-    ClearPostOrder(node->left);
-    ClearPostOrder(node->right);
-    FreeResource_(node);
-    --size_;
-    if (size_ == 0) {
-      root_ = impl_.nil;
-      impl_.min = impl_.nil;
-      impl_.max = impl_.nil;
-      if (impl_.nil != impl_.end) FreeResource_(impl_.end);
-      impl_.end = impl_.nil;
+  // Iterative, in the order of (right subtree, node, left subtree) : the
+  // nodes waiting for their right subtree to be freed are kept in a fixed
+  // array. A red-black tree of n nodes is at most 2 log2(n + 1) high, so two
+  // entries per bit of size_type are enough, with no allocation.
+  // returns the number of freed nodes
+  size_type ClearPostOrder_(BasePtr node) {
+    BasePtr pending[2 * sizeof(size_type) * 8];
+    size_type n_pending = 0;
+    size_type n_freed = 0;
+    for (;;) {
+      if (node != NULL) {
+        pending[n_pending++] = node;
+        node = node->right;
+        continue;
+      }
+      if (n_pending == 0) break;
+      node = pending[--n_pending];
+      BasePtr left = node->left;
+      FreeNode_(node);
+      ++n_freed;
+      node = left;
+    }
+    return n_freed;
+  }
+
+  // keys which need no destructor call are released with their slabs
+  void ClearNodes_(true_type) {}
+
+  void ClearNodes_(false_type) { ClearPostOrder_(Root_()); }
+
+  // SECTION : split & join
+  // below this many elements, a range is erased one by one rather than split
+  // out of the tree
+  enum { kMinSplitErase_ = 64 };
+
+  // Subtrees are handled detached from the tree, with their black height
+  // (the black nodes on any path down from the root, NULL counting as 0).
+  // header_ only serves as a temporary parent for the subtree being worked
+  // on, so that the rotations & AdjustAfterInsert_ can be used as they are.
+  static size_type BlackHeight_(BasePtr node) {
+    size_type height = 0;
+    for (; node != NULL; node = node->left)
+      if (node->Color() == kBlack) ++height;
+    return height;
+  }
+
+  // turns a red root black, returns the black height it adds
+  static size_type Blacken_(BasePtr root) {
+    if (root == NULL || root->Color() == kBlack) return 0;
+    root->SetColor(kBlack);
+    return 1;
+  }
+
+  // the tree of left, mid & right, where left < mid < right
+  // mid is attached, red, down the spine of the higher tree where the black
+  // heights match, then rebalanced as an insertion. O(1 + height
+  // difference), which makes a series of joins along a path O(log n)
+  BasePtr Join_(BasePtr left, size_type left_height, BasePtr mid,
+                BasePtr right, size_type right_height, size_type* height) {
+    left_height += Blacken_(left);
+    right_height += Blacken_(right);
+    const bool left_higher = (left_height >= right_height);
+    const size_type low_height = left_higher ? right_height : left_height;
+    BasePtr node = left_higher ? left : right;
+    size_type node_height = left_higher ? left_height : right_height;
+    BasePtr parent = &header_;
+    SetRoot_(node);
+    if (node != NULL) node->SetParent(&header_);
+    while (!(IsBlack_(node) && node_height == low_height)) {
+      if (node->Color() == kBlack) --node_height;
+      parent = node;
+      node = left_higher ? node->right : node->left;
+    }
+    mid->SetColor(kRed);
+    mid->left = left_higher ? node : left;
+    mid->right = left_higher ? right : node;
+    if (mid->left != NULL) mid->left->SetParent(mid);
+    if (mid->right != NULL) mid->right->SetParent(mid);
+    mid->SetParent(parent);
+    if (parent == &header_)
+      SetRoot_(mid);
+    else if (left_higher)
+      parent->right = mid;
+    else
+      parent->left = mid;
+    Augment::RecountPath(mid, &header_);
+    const size_type high_height = left_higher ? left_height : right_height;
+    *height = high_height + (AdjustAfterInsert_(mid) ? 1 : 0);
+    return Root_();
+  }
+
+  // cuts the subtree of node (of black height height) into the keys less
+  // than key (*less) & greater than key (*greater), returns the node equal to
+  // key, detached, or NULL
+  template <typename K>
+  BasePtr Split_(BasePtr node, size_type height, const K& key,
+                 BasePtr* less, size_type* less_height, BasePtr* greater,
+                 size_type* greater_height) {
+    if (node == NULL) {
+      *less = NULL;
+      *greater = NULL;
+      *less_height = 0;
+      *greater_height = 0;
+      return NULL;
+    }
+    const size_type child_height = height - (node->Color() == kBlack);
+    BasePtr left = node->left;
+    BasePtr right = node->right;
+    BasePtr found = NULL;
+    if (comp_(key, Key_(node))) {
+      BasePtr part = NULL;
+      size_type part_height = 0;
+      found = Split_(left, child_height, key, less, less_height, &part,
+                     &part_height);
+      *greater = Join_(part, part_height, node, right, child_height,
+                       greater_height);
+    } else if (comp_(Key_(node), key)) {
+      BasePtr part = NULL;
+      size_type part_height = 0;
+      found = Split_(right, child_height, key, &part, &part_height, greater,
+                     greater_height);
+      *less = Join_(left, child_height, node, part, part_height, less_height);
+    } else {
+      found = node;
+      *less = left;
+      *greater = right;
+      *less_height = child_height;
+      *greater_height = child_height;
+    }
+    return found;
+  }
+
+  // makes root (detached, possibly NULL) the whole tree
+  void InstallRoot_(BasePtr root) {
+    if (root == NULL) {
+      ResetHeader_();
+      return;
     }
+    SetRoot_(root);
+    root->SetParent(&header_);
+    root->SetColor(kBlack);
+    header_.left = RbTreeNodeBase::Min(root);
+    header_.right = RbTreeNodeBase::Max(root);
+    Augment::ThreadEnds(&header_);
+  }
+
+  // the sizes of this tree & other after a split of total elements : known
+  // by the root with an augmentation counting nodes, counted otherwise by
+  // walking both trees side by side, until the smaller one ends
+  void SetSplitSizes_(RbTree& other, size_type total, true_type) {
+    size_ = Augment::Count(Root_());
+    other.size_ = total - size_;
+  }
+
+  void SetSplitSizes_(RbTree& other, size_type total, false_type) {
+    BasePtr node = header_.left;
+    BasePtr other_node = other.header_.left;
+    size_type n_steps = 0;
+    while (node != &header_ && other_node != &other.header_) {
+      node = NodeBase::Increment(node);
+      other_node = NodeBase::Increment(other_node);
+      ++n_steps;
+    }
+    size_ = (node == &header_) ? n_steps : total - n_steps;
+    other.size_ = total - size_;
+  }
+
+ public:
+  void Clear(void) {
+    ClearNodes_(typename is_trivially_destructible<ValueType>::type());
+    pool_.Release();
+    ResetHeader_();
+    size_ = 0;
   }
 
   // search
-  iterator Search(const KeyType& key_value) const {
-    NodePtr node = root_;
-    while (node != impl_.nil &&
-           (comp_(node->key, key_value) || comp_(key_value, node->key)))
-      node = comp_(key_value, node->key) ? node->left : node->right;
-    return (node == impl_.nil) ? iterator(impl_.end) : iterator(node);
+  template <typename K>
+  iterator Search(const K& key) const {
+    BasePtr node = LowerBound(key).base();
+    if (node == End_() || comp_(key, Key_(node))) node = End_();
+    return iterator(node);
   }
 
   // insert
   // The inserted node is colored red initially, if the Red-Black tree's
   // properties are not kept by inserting the new node, rotations and/or
   // recoloring take place in AdjustAfterInsert_
-  // NOTE : the new Node's color is initialized to red in the Node's
-  // constructor
-  pair<iterator, bool> Insert(const KeyType& key_value, NodePtr cursor = NULL) {
-    NodePtr trailing = impl_.nil;
-    if (cursor == NULL) {
-      cursor = root_;
-      while (cursor != impl_.nil) {
-        trailing = cursor;
-        if (!comp_(key_value, cursor->key) && !comp_(cursor->key, key_value))
-          return ft::make_pair(iterator(cursor), false);
-        cursor = comp_(key_value, cursor->key) ? cursor->left : cursor->right;
-      }
-    } else {
-      NodePtr successor = cursor->FindSuccessor();
-      while (successor != impl_.end && !(comp_(cursor->key, key_value) &&
-                                         comp_(key_value, successor->key))) {
-        cursor = successor;
-        successor = cursor->FindSuccessor();
-      }
-      trailing = cursor;
-    }
-    NodePtr node = alloc_.allocate(1);
-    alloc_.construct(node, Node(impl_.nil, false, kRed, key_value));
-    node->parent = trailing;
-    if (trailing == impl_.nil) {
-      node->color = kBlack;
-      root_ = node;
-    } else if (comp_(node->key, trailing->key))
-      trailing->left = node;
+  pair<iterator, bool> Insert(const ValueType& value) {
+    return InsertUnique_(KeyOf_(value), CopyValue_(value));
+  }
+
+  // emplace
+  // Looks key up first, and only on a miss constructs the element in the
+  // new node with make(alloc, ptr), which must give it an equivalent key
+  template <typename Maker>
+  pair<iterator, bool> Emplace(const KeyType& key, const Maker& make) {
+    return InsertUnique_(key, make);
+  }
+
+  template <typename Maker>
+  pair<iterator, bool> Emplace(const KeyType& key, const Maker& make,
+                               BasePtr hint) {
+    return InsertUnique_(key, make, hint);
+  }
+
+  // range
+  // sorted & unique input into an empty tree is built in O(n), anything else
+  // is inserted one by one with end() as hint
+  template <typename InputIterator>
+  void InsertRange(
+      InputIterator first,
+      typename enable_if<!is_forward_iterator<InputIterator>::value,
+                         InputIterator>::type last) {
+    for (; first != last; ++first) Insert(*first, &header_);
+  }
+
+  template <typename InputIterator>
+  void InsertRange(
+      InputIterator first,
+      typename enable_if<is_forward_iterator<InputIterator>::value,
+                         InputIterator>::type last) {
+    if (size_ == 0 && IsSortedUnique_(first, last))
+      Build_(first, static_cast<size_type>(std::distance(first, last)));
     else
-      trailing->right = node;
-    AdjustAfterInsert_(node);
-    ++size_;
-    if (!(size_ == 1 && node == root_)) {
-      if (comp_(node->key, impl_.min->key))
-        impl_.min = node;
-      else if (comp_(impl_.max->key, node->key)) {
-        impl_.max = node;
-        impl_.end->parent = node;
-      }
-    } else {
-      impl_.min = root_;
-      impl_.max = root_;
-      impl_.end->parent = node;
+      for (; first != last; ++first) Insert(*first, &header_);
+  }
+
+  // the caller guarantees that [first, last) is sorted & unique
+  template <typename InputIterator>
+  void InsertSortedUnique(
+      InputIterator first,
+      typename enable_if<!is_forward_iterator<InputIterator>::value,
+                         InputIterator>::type last) {
+    if (size_ != 0) {
+      for (; first != last; ++first) Insert(*first, &header_);
+      return;
     }
-    return ft::make_pair(iterator(node), true);
+    // the size is unknown : every key goes right of the max
+    for (; first != last; ++first) InsertAt_(header_.right, kRight, *first);
+  }
+
+  template <typename InputIterator>
+  void InsertSortedUnique(
+      InputIterator first,
+      typename enable_if<is_forward_iterator<InputIterator>::value,
+                         InputIterator>::type last) {
+    if (size_ == 0)
+      Build_(first, static_cast<size_type>(std::distance(first, last)));
+    else
+      for (; first != last; ++first) Insert(*first, &header_);
+  }
+
+  // hinted insert
+  // The key is checked against the hint and its neighbour, and attached
+  // right there when it belongs between them : O(1) amortized for a good
+  // hint (e.g. end() for ascending keys), O(log n) otherwise
+  pair<iterator, bool> Insert(const ValueType& value, BasePtr hint) {
+    return InsertUnique_(KeyOf_(value), CopyValue_(value), hint);
   }
 
   // delete
-  // NOTE : will need multiple case specialization
-  // x : replacement, y : check_color, z : node
-  void Delete(NodePtr node, const KeyType& key_value = KeyType()) {
-    if (node == NULL) node = Search(key_value).base();
-    if (size_ == 1 && node == root_) {
-      DeleteLastNode_();
+  void Delete(BasePtr node) {
+    if (node == &header_) return;
+    Unlink_(node);
+    FreeNode_(node);
+    --size_;
+  }
+
+  // erases [first, last), the whole tree is cleared in one pass
+  // Short ranges are erased one by one. Longer ones are split out of the
+  // tree, freed in one pass, and what is left on both sides joined back :
+  // O(log n + k) for k elements, instead of k rebalancing deletions.
+  void DeleteRange(BasePtr first, BasePtr last) {
+    if (first == header_.left && last == &header_) {
+      Clear();
       return;
     }
-    if (node == impl_.end) return;
-    NodePtr x = impl_.nil;
-    bool original_color = node->color;
-    if (node->left == impl_.nil) {
-      x = node->right;
-      Transplant_(node, node->right);
-    } else if (node->right == impl_.nil) {
-      x = node->left;
-      Transplant_(node, node->left);
-    } else {
-      NodePtr y = node;
-      y = Node::Min(node->right);
-      original_color = y->color;
-      x = y->right;
-      if (y->parent == node)
-        x->parent = y;
-      else {
-        x = y->right;
-        Transplant_(y, y->right);
-        y->right = node->right;
-        y->right->parent = y;
+    BasePtr node = first;
+    for (int i = 0; i < kMinSplitErase_ && node != last; ++i)
+      node = NodeBase::Increment(node);
+    if (node == last) {
+      while (first != last) {
+        BasePtr next = NodeBase::Increment(first);
+        Delete(first);
+        first = next;
       }
-      Transplant_(node, y);
-      y->left = node->left;
-      y->left->parent = y;
-      y->color = node->color;
+      return;
     }
-    FreeResource_(node);
-    --size_;
-    if (original_color == kBlack) AdjustAfterDelete_(x);
+    // the split & joins keep the in-order links, only the gap is closed
+    Augment::Thread(NodeBase::Decrement(first), last);
+    BasePtr less = NULL;
+    BasePtr middle = NULL;
+    BasePtr greater = NULL;
+    size_type less_height = 0;
+    size_type middle_height = 0;
+    size_type greater_height = 0;
+    Split_(Root_(), BlackHeight_(Root_()), Key_(first), &less, &less_height,
+           &middle, &middle_height);
+    BasePtr root = less;
+    if (last != &header_) {
+      Split_(middle, middle_height, Key_(last), &middle, &middle_height,
+             &greater, &greater_height);
+      root = Join_(less, less_height, last, greater, greater_height,
+                   &less_height);
+    }
+    size_ -= ClearPostOrder_(middle) + 1;
+    FreeNode_(first);
+    InstallRoot_(root);
+  }
+
+  // split & join
+  // moves the elements not less than key to greater (cleared first), in
+  // O(log n) (plus the walk of the smaller part, to size both trees, unless
+  // the augmentation counts nodes)
+  template <typename K>
+  void Split(const K& key, RbTree& greater) {
+    if (&greater == this) return;
+    greater.Clear();
+    if (size_ == 0) return;
+    const size_type total = size_;
+    BasePtr less = NULL;
+    BasePtr rest = NULL;
+    size_type less_height = 0;
+    size_type rest_height = 0;
+    BasePtr found = Split_(Root_(), BlackHeight_(Root_()), key, &less,
+                           &less_height, &rest, &rest_height);
+    if (found != NULL)
+      rest = Join_(NULL, 0, found, rest, rest_height, &rest_height);
+    InstallRoot_(less);
+    greater.InstallRoot_(rest);
+    if (rest != NULL) pool_.Share(greater.pool_);
+    SetSplitSizes_(greater, total, typename Augment::CountsNodes());
   }
 
-  // print
-  // void PrintInOrder(NodePtr node, int depth = 0) {
-  //   if (node == impl_.nil) return;
-  //   PrintInOrder(node->left, depth + 1);
-  //   std::cout << node->key << " ";
-  //   PrintInOrder(node->right, depth + 1);
-  // }
+  // moves the elements of other into this tree, in O(log n) when all the
+  // keys of one tree are less than all the keys of the other. Otherwise they
+  // are inserted one by one, and those whose key is already in this tree
+  // stay in other.
+  void Join(RbTree& other) {
+    if (&other == this || other.size_ == 0) return;
+    if (size_ == 0) {
+      Swap(other);
+      return;
+    }
+    // other's min (or max) joins both trees
+    const bool other_after = comp_(Key_(header_.right),
+                                   Key_(other.header_.left));
+    if (!other_after && !comp_(Key_(other.header_.right), Key_(header_.left))) {
+      BasePtr node = other.header_.left;
+      while (node != &other.header_) {
+        BasePtr next = NodeBase::Increment(node);
+        if (Insert(Value_(node), &header_).second) other.Delete(node);
+        node = next;
+      }
+      return;
+    }
+    const size_type total = size_ + other.size_;
+    BasePtr mid = other_after ? other.header_.left : other.header_.right;
+    other.Unlink_(mid);
+    if (other_after) {
+      Augment::Thread(header_.right, mid);
+      Augment::Thread(mid, other.header_.left);
+    } else {
+      Augment::Thread(other.header_.right, mid);
+      Augment::Thread(mid, header_.left);
+    }
+    BasePtr mine = Root_();
+    BasePtr theirs = other.Root_();
+    size_type height = 0;
+    BasePtr root = NULL;
+    if (other_after)
+      root = Join_(mine, BlackHeight_(mine), mid, theirs,
+                   BlackHeight_(theirs), &height);
+    else
+      root = Join_(theirs, BlackHeight_(theirs), mid, mine,
+                   BlackHeight_(mine), &height);
+    InstallRoot_(root);
+    size_ = total;
+    other.ResetHeader_();
+    other.size_ = 0;
+    pool_.Merge(other.pool_);
+  }
 
   // iterators
-  iterator begin(void) FT_NOEXCEPT_ { return iterator(impl_.min); }
+  iterator begin(void) FT_NOEXCEPT_ { return iterator(header_.left); }
 
   const_iterator begin(void) const FT_NOEXCEPT_ {
-    return const_iterator(impl_.min);
+    return const_iterator(header_.left);
   }
 
-  iterator end(void) FT_NOEXCEPT_ { return iterator(impl_.end); }
+  iterator end(void) FT_NOEXCEPT_ { return iterator(&header_); }
 
-  const_iterator end(void) const FT_NOEXCEPT_ {
-    return const_iterator(impl_.end);
-  }
+  const_iterator end(void) const FT_NOEXCEPT_ { return const_iterator(End_()); }
 
   reverse_iterator rbegin(void) FT_NOEXCEPT_ { return reverse_iterator(end()); }
 
@@ -713,11 +1615,12 @@ class RbTree {
   }
 
   // Operations
-  iterator LowerBound(const KeyType& key) {
-    NodePtr node = root_;
-    NodePtr ret = impl_.end;
-    while (node != impl_.nil) {
-      if (!comp_(node->key, key)) {
+  template <typename K>
+  iterator LowerBound(const K& key) const {
+    BasePtr node = Root_();
+    BasePtr ret = End_();
+    while (node != NULL) {
+      if (!comp_(Key_(node), key)) {
         ret = node;
         node = node->left;
       } else
@@ -726,79 +1629,83 @@ class RbTree {
     return iterator(ret);
   }
 
-  const_iterator LowerBound(const KeyType& key) const {
-    NodePtr node = root_;
-    NodePtr ret = impl_.end;
-    while (node != impl_.nil) {
-      if (!comp_(node->key, key)) {
+  template <typename K>
+  iterator UpperBound(const K& key) const {
+    BasePtr node = Root_();
+    BasePtr ret = End_();
+    while (node != NULL) {
+      if (comp_(key, Key_(node))) {
         ret = node;
         node = node->left;
       } else
         node = node->right;
     }
-    return const_iterator(ret);
+    return iterator(ret);
   }
 
-  iterator UpperBound(const KeyType& key) {
-    NodePtr node = root_;
-    NodePtr ret = impl_.end;
-    while (node != impl_.nil) {
-      if (comp_(key, node->key)) {
-        ret = node;
+  // order statistics (with an augmentation providing Count only)
+  // the k-th smallest element (from 0), end() if k >= size
+  iterator Select(size_type k) const {
+    BasePtr node = Root_();
+    while (node != NULL) {
+      const size_type n_left = Augment::Count(node->left);
+      if (k == n_left) return iterator(node);
+      if (k < n_left)
         node = node->left;
-      } else
+      else {
+        k -= n_left + 1;
         node = node->right;
+      }
     }
-    return iterator(ret);
+    return iterator(End_());
   }
 
-  const_iterator UpperBound(const KeyType& key) const {
-    NodePtr node = root_;
-    NodePtr ret = impl_.end;
-    while (node != impl_.nil) {
-      if (comp_(key, node->key)) {
-        ret = node;
-        node = node->left;
-      } else
+  // the number of elements less than key
+  template <typename K>
+  size_type Rank(const K& key) const {
+    BasePtr node = Root_();
+    size_type rank = 0;
+    while (node != NULL) {
+      if (comp_(Key_(node), key)) {
+        rank += Augment::Count(node->left) + 1;
         node = node->right;
+      } else
+        node = node->left;
     }
-    return const_iterator(ret);
+    return rank;
   }
 
   // getter
-  NodePtr GetRoot(void) const { return root_; }
-
   size_type GetSize(void) const { return size_; }
 
   // swap
+  // the headers stay in place, only their contents are exchanged
   void Swap(RbTree& x) {
-    NodePtr root_temp = root_;
-    RbTreeImpl_ impl_temp = impl_;
-    size_type size_temp = size_;
-    root_ = x.root_;
-    impl_ = x.impl_;
-    size_ = x.size_;
-    x.root_ = root_temp;
-    x.impl_ = impl_temp;
-    x.size_ = size_temp;
+    std::swap(header_, x.header_);
+    std::swap(size_, x.size_);
+    pool_.Swap(x.pool_);
+    AdoptHeader_();
+    x.AdoptHeader_();
+  }
+
+  // room for n elements in the node pool
+  void Reserve(size_type n) {
+    if (n > size_) pool_.Reserve(n - size_);
   }
 
   // max allocation size
-  size_type MaxSize(void) const { return alloc_.max_size(); }
-
-  // void print_tree(const std::string& prefix, NodePtr x, bool isLeft) {
-  //   if (x != impl_.nil) {
-  //     std::cout << prefix;
-  //     std::cout << (isLeft ? "L├──" : "R└──");
-  //     if (x->color == kRed) {
-  //       std::cout << R << x->key.first << RESET << "\n";
-  //     } else {
-  //       std::cout << B << x->key.first << RESET << "\n";
-  //     }
-  //     print_tree(prefix + (isLeft ? " │   " : "     "), x->left, true);
-  //     print_tree(prefix + (isLeft ? " │   " : "     "), x->right, false);
-  //   };
-  // }
+  size_type MaxSize(void) const { return AllocNodeType(alloc_).max_size(); }
+
+ private:
+  // points the root (or the empty header) back at this tree's header
+  void AdoptHeader_(void) {
+    if (Root_() == NULL) {
+      ResetHeader_();
+      return;
+    }
+    Root_()->SetParent(&header_);
+    Augment::ThreadEnds(&header_);
+  }
 };
 }  // namespace ft
 
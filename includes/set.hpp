@@ -19,8 +19,11 @@
 #include "utility.hpp"
 
 namespace ft {
+// Augment is no_order_statistics, order_statistics for nth, rank &
+// count_range, or threaded for O(1) iterator steps (ft only)
 template <typename Key, typename Compare = std::less<Key>,
-          typename Alloc = std::allocator<Key> >
+          typename Alloc = std::allocator<Key>,
+          typename Augment = no_order_statistics>
 class set {
  public:
   typedef Key key_type;
@@ -34,10 +37,18 @@ class set {
   typedef typename allocator_type::const_pointer const_pointer;
 
  private:
-  typedef RbTree<key_type, key_compare, allocator_type> Base_;
+  typedef RbTree<value_type, RbTreeIdentity<value_type>, key_compare,
+                 allocator_type, Augment>
+      Base_;
   typedef typename Base_::Node Node_;
   typedef typename Base_::NodePtr NodePtr_;
 
+  // the return type R of a lookup by a key of type K, if Compare is
+  // transparent (depends on K, so that it is a substitution failure)
+  template <typename K, typename R>
+  struct IfTransparent_
+      : public enable_if<has_is_transparent<Compare>::value, R> {};
+
   key_compare comp_;
   allocator_type alloc_;
   Base_ tree_;
@@ -54,7 +65,7 @@ class set {
   // #1 empty : empty container with no element
   explicit set(const key_compare& comp = key_compare(),
                const allocator_type& alloc = allocator_type())
-      : comp_(comp), alloc_(alloc), tree_(Base_(comp_, alloc_)) {}
+      : comp_(comp), alloc_(alloc), tree_(comp_, alloc_) {}
 
   // #2 range : constructs with as many elements as the range [first, last)
   template <typename InputIterator>
@@ -63,15 +74,27 @@ class set {
                          InputIterator>::type last,
       const key_compare& comp = key_compare(),
       const allocator_type& alloc = allocator_type())
-      : comp_(comp), alloc_(alloc), tree_(Base_(comp_, alloc_)) {
-    for (; first != last; ++first) insert(*first);
+      : comp_(comp), alloc_(alloc), tree_(comp_, alloc_) {
+    tree_.InsertRange(first, last);
+  }
+
+  // #2' sorted range (ft only) : [first, last) is sorted & unique, the tree
+  // is built in O(n)
+  template <typename InputIterator>
+  set(sorted_unique_t, InputIterator first,
+      typename enable_if<is_input_iterator<InputIterator>::value,
+                         InputIterator>::type last,
+      const key_compare& comp = key_compare(),
+      const allocator_type& alloc = allocator_type())
+      : comp_(comp), alloc_(alloc), tree_(comp_, alloc_) {
+    tree_.InsertSortedUnique(first, last);
   }
 
   // #3 copy constructor
   set(const set& original)
       : comp_(original.comp_),
         alloc_(original.alloc_),
-        tree_(Base_(original.tree_)) {}
+        tree_(original.tree_) {}
 
   // Destructor
   ~set(void) FT_NOEXCEPT_ {}
@@ -80,8 +103,7 @@ class set {
   set& operator=(const set& rhs) {
     comp_ = rhs.comp_;
     alloc_ = rhs.alloc_;
-    tree_.~Base_();
-    tree_ = Base_(rhs.tree_);
+    tree_ = rhs.tree_;
     return *this;
   }
 
@@ -101,6 +123,9 @@ class set {
 
   size_type max_size(void) const FT_NOEXCEPT_ { return tree_.MaxSize(); }
 
+  // pre-sizes the node pool for n elements (ft only)
+  void reserve(size_type n) { tree_.Reserve(n); }
+
   // Modifiers
   // single element
   pair<iterator, bool> insert(const value_type& val) {
@@ -108,10 +133,9 @@ class set {
   }
 
   // single element at a given position
+  // O(1) amortized when val goes right before or after position
   iterator insert(iterator position, const value_type& val) {
-    return (position != end() && val > *position)
-               ? tree_.Insert(val, position.base()).first
-               : insert(val).first;
+    return tree_.Insert(val, position.base()).first;
   }
 
   // range
@@ -119,7 +143,15 @@ class set {
   void insert(InputIterator first,
               typename enable_if<is_input_iterator<InputIterator>::value,
                                  InputIterator>::type last) {
-    for (; first != last; ++first) insert(*first);
+    tree_.InsertRange(first, last);
+  }
+
+  // sorted range : [first, last) is sorted & unique (ft only)
+  template <typename InputIterator>
+  void insert(sorted_unique_t, InputIterator first,
+              typename enable_if<is_input_iterator<InputIterator>::value,
+                                 InputIterator>::type last) {
+    tree_.InsertSortedUnique(first, last);
   }
 
   // single element at a given position
@@ -127,25 +159,31 @@ class set {
 
   // single element with a given key
   size_type erase(const value_type& val) {
-    size_type original = size();
-    tree_.Delete(NULL, val);
-    return original - size();
+    iterator position = find(val);
+    if (position == end()) return 0;
+    erase(position);
+    return 1;
   }
 
   // range
   void erase(iterator first, iterator last) {
-    iterator tmp;
-    for (; first != last;) {
-      tmp = first;
-      ++tmp;
-      tree_.Delete(first.base());
-      first = tmp;
-    }
+    tree_.DeleteRange(first.base(), last.base());
   }
 
   void swap(set& x) { tree_.Swap(x.tree_); }
 
-  void clear(void) FT_NOEXCEPT_ { tree_.ClearPostOrder(tree_.GetRoot()); }
+  void clear(void) FT_NOEXCEPT_ { tree_.Clear(); }
+
+  // split & join (ft only)
+  // moves the elements not less than key to greater, which is cleared first
+  void split(const key_type& key, set& greater) {
+    tree_.Split(key, greater.tree_);
+  }
+
+  // moves the elements of other into this set : O(log n) when all the keys of
+  // one come before all the keys of the other, otherwise like insert(), and
+  // the elements whose key is already here stay in other
+  void join(set& other) { tree_.Join(other.tree_); }
 
   // Observers
   key_compare key_comp(void) const { return comp_; }
@@ -171,50 +209,92 @@ class set {
     return ft::make_pair(lower_bound(val), upper_bound(val));
   }
 
+  // heterogeneous lookup (ft only) : with a transparent Compare (e.g.
+  // ft::less<>), a key of any type Compare accepts is used as it is
+  template <typename K>
+  typename IfTransparent_<K, iterator>::type find(const K& k) const {
+    return tree_.Search(k);
+  }
+
+  template <typename K>
+  typename IfTransparent_<K, size_type>::type count(const K& k) const {
+    return iterator(tree_.Search(k)) == tree_.end() ? 0 : 1;
+  }
+
+  template <typename K>
+  typename IfTransparent_<K, iterator>::type lower_bound(const K& key) const {
+    return tree_.LowerBound(key);
+  }
+
+  template <typename K>
+  typename IfTransparent_<K, iterator>::type upper_bound(const K& key) const {
+    return tree_.UpperBound(key);
+  }
+
+  template <typename K>
+  typename IfTransparent_<K, pair<iterator, iterator> >::type equal_range(
+      const K& key) const {
+    return ft::make_pair(lower_bound(key), upper_bound(key));
+  }
+
+  // Order statistics (ft only, with order_statistics as Augment)
+  // the k-th smallest element (from 0) in O(log n), end() if k >= size()
+  iterator nth(size_type k) const { return tree_.Select(k); }
+
+  // the number of elements less than key, in O(log n)
+  size_type rank(const key_type& key) const { return tree_.Rank(key); }
+
+  // the number of elements in [lo, hi), in O(log n)
+  size_type count_range(const key_type& lo, const key_type& hi) const {
+    if (!comp_(lo, hi)) return 0;
+    return tree_.Rank(hi) - tree_.Rank(lo);
+  }
+
   // Allocator
   allocator_type get_allocator(void) const FT_NOEXCEPT_ { return alloc_; }
 };
 
-template <typename Key, typename Compare, typename Alloc>
-bool operator==(const set<Key, Compare, Alloc>& lhs,
-                const set<Key, Compare, Alloc>& rhs) {
+template <typename Key, typename Compare, typename Alloc, typename Augment>
+bool operator==(const set<Key, Compare, Alloc, Augment>& lhs,
+                const set<Key, Compare, Alloc, Augment>& rhs) {
   return (lhs.size() == rhs.size() &&
-          equal(lhs.begin(), lhs.end(), rhs.begin()));
+          ft::equal(lhs.begin(), lhs.end(), rhs.begin()));
 }
 
-template <typename Key, typename Compare, typename Alloc>
-bool operator!=(const set<Key, Compare, Alloc>& lhs,
-                const set<Key, Compare, Alloc>& rhs) {
+template <typename Key, typename Compare, typename Alloc, typename Augment>
+bool operator!=(const set<Key, Compare, Alloc, Augment>& lhs,
+                const set<Key, Compare, Alloc, Augment>& rhs) {
   return !(lhs == rhs);
 }
 
-template <typename Key, typename Compare, typename Alloc>
-bool operator<(const set<Key, Compare, Alloc>& lhs,
-               const set<Key, Compare, Alloc>& rhs) {
-  return lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(),
-                                 rhs.end());
+template <typename Key, typename Compare, typename Alloc, typename Augment>
+bool operator<(const set<Key, Compare, Alloc, Augment>& lhs,
+               const set<Key, Compare, Alloc, Augment>& rhs) {
+  return ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(),
+                                     rhs.end());
 }
 
-template <typename Key, typename Compare, typename Alloc>
-bool operator<=(const set<Key, Compare, Alloc>& lhs,
-                const set<Key, Compare, Alloc>& rhs) {
+template <typename Key, typename Compare, typename Alloc, typename Augment>
+bool operator<=(const set<Key, Compare, Alloc, Augment>& lhs,
+                const set<Key, Compare, Alloc, Augment>& rhs) {
   return !(rhs < lhs);
 }
 
-template <typename Key, typename Compare, typename Alloc>
-bool operator>(const set<Key, Compare, Alloc>& lhs,
-               const set<Key, Compare, Alloc>& rhs) {
+template <typename Key, typename Compare, typename Alloc, typename Augment>
+bool operator>(const set<Key, Compare, Alloc, Augment>& lhs,
+               const set<Key, Compare, Alloc, Augment>& rhs) {
   return rhs < lhs;
 }
 
-template <typename Key, typename Compare, typename Alloc>
-bool operator>=(const set<Key, Compare, Alloc>& lhs,
-                const set<Key, Compare, Alloc>& rhs) {
+template <typename Key, typename Compare, typename Alloc, typename Augment>
+bool operator>=(const set<Key, Compare, Alloc, Augment>& lhs,
+                const set<Key, Compare, Alloc, Augment>& rhs) {
   return !(lhs < rhs);
 }
 
-template <typename Key, typename Compare, typename Alloc>
-void swap(set<Key, Compare, Alloc>& x, set<Key, Compare, Alloc>& y) {
+template <typename Key, typename Compare, typename Alloc, typename Augment>
+void swap(set<Key, Compare, Alloc, Augment>& x,
+          set<Key, Compare, Alloc, Augment>& y) {
   x.swap(y);
 }
 }  // namespace ft
@@ -0,0 +1,227 @@
+/**
+ * @file small_vector.hpp
+ * @author ghan (ghan@student.42seoul.kr)
+ * @brief A header file for small_vector container (vector with inline storage)
+ * @date 2022-07-04
+ */
+
+#ifndef FT_CONTAINERS_INCLUDES_SMALL_VECTOR_HPP_
+#define FT_CONTAINERS_INCLUDES_SMALL_VECTOR_HPP_
+
+#define FT_NOEXCEPT_ throw()
+
+#include <cstddef>
+#include <memory>
+
+#include "algorithm.hpp"
+#include "iterator_traits.hpp"
+#include "type_traits.hpp"
+#include "vector.hpp"
+
+namespace ft {
+
+// SECTION : inline buffer
+// raw, suitably aligned room for N elements. It is a separate base class so
+// that it is constructed before the vector which points into it.
+template <typename T, size_t N>
+struct SmallVectorBuffer {
+  union {
+    char bytes[N * sizeof(T)];
+    long double align_float;
+    void* align_ptr;
+    long align_int;
+  } storage;
+
+  // leaves the storage uninitialized
+  SmallVectorBuffer(void) {}
+
+  T* InlineBegin_(void) { return reinterpret_cast<T*>(storage.bytes); }
+
+  const T* InlineBegin_(void) const {
+    return reinterpret_cast<const T*>(storage.bytes);
+  }
+};
+
+// SECTION : small_vector
+// ft::vector which keeps up to N elements inline, and moves to the heap (for
+// good) once it outgrows them. Every vector member function works unchanged,
+// only the ones which hand storage over (copy, assignment, swap) differ.
+// NOTE : the inheritance is private so that a small_vector can not be swapped
+// with, or assigned through, a plain vector
+template <typename T, size_t N, typename Alloc = std::allocator<T>,
+          typename Growth = GrowthDouble>
+class small_vector : private SmallVectorBuffer<T, N>,
+                     private vector<T, Alloc, Growth> {
+ private:
+  typedef SmallVectorBuffer<T, N> Buffer_;
+  typedef vector<T, Alloc, Growth> Base_;
+
+ public:
+  // SECTION : member types
+  typedef typename Base_::value_type value_type;
+  typedef typename Base_::allocator_type allocator_type;
+  typedef typename Base_::growth_policy growth_policy;
+  typedef typename Base_::size_type size_type;
+  typedef typename Base_::difference_type difference_type;
+  typedef typename Base_::pointer pointer;
+  typedef typename Base_::const_pointer const_pointer;
+  typedef typename Base_::reference reference;
+  typedef typename Base_::const_reference const_reference;
+  typedef typename Base_::iterator iterator;
+  typedef typename Base_::const_iterator const_iterator;
+  typedef typename Base_::reverse_iterator reverse_iterator;
+  typedef typename Base_::const_reverse_iterator const_reverse_iterator;
+
+  static const size_type inline_capacity = N;
+
+  // SECTION : constructors & destructor
+  // #1 default : empty container, no allocation
+  explicit small_vector(const allocator_type& alloc = allocator_type())
+      : Buffer_(), Base_(Buffer_::InlineBegin_(), N, alloc) {}
+
+  // #2 fill
+  explicit small_vector(size_type n, const value_type& val = value_type(),
+                        const allocator_type& alloc = allocator_type())
+      : Buffer_(), Base_(Buffer_::InlineBegin_(), N, alloc) {
+    Base_::assign(n, val);
+  }
+
+  // #3 range
+  template <typename InputIterator>
+  small_vector(InputIterator first,
+               typename enable_if<is_input_iterator<InputIterator>::value,
+                                  InputIterator>::type last,
+               const allocator_type& alloc = allocator_type())
+      : Buffer_(), Base_(Buffer_::InlineBegin_(), N, alloc) {
+    Base_::assign(first, last);
+  }
+
+  // #4 copy constructor
+  small_vector(const small_vector& x)
+      : Buffer_(), Base_(Buffer_::InlineBegin_(), N, x.get_allocator()) {
+    Base_::assign(x.begin(), x.end());
+  }
+
+  // destructor
+  // the inline buffer must not reach the allocator in ~VectorBase
+  ~small_vector(void) FT_NOEXCEPT_ {
+    Base_::clear();
+    if (IsInlineStorage_()) {
+      this->begin_ = NULL;
+      this->end_ = NULL;
+      this->end_of_storage_ = NULL;
+    }
+  }
+
+  // SECTION : operator=
+  small_vector& operator=(const small_vector& x) {
+    if (this != &x) Base_::assign(x.begin(), x.end());
+    return *this;
+  }
+
+  // SECTION : vector interface
+  using Base_::begin;
+  using Base_::end;
+  using Base_::rbegin;
+  using Base_::rend;
+
+  using Base_::size;
+  using Base_::max_size;
+  using Base_::resize;
+  using Base_::capacity;
+  using Base_::empty;
+  using Base_::reserve;
+
+  using Base_::operator[];
+  using Base_::at;
+  using Base_::front;
+  using Base_::back;
+
+  using Base_::assign;
+  using Base_::push_back;
+  using Base_::pop_back;
+  using Base_::insert;
+  using Base_::erase;
+  using Base_::clear;
+
+  using Base_::get_allocator;
+
+  // pointers are exchanged only when neither side lives inline
+  void swap(small_vector& x) {
+    if (!IsInlineStorage_() && !x.IsInlineStorage_()) {
+      Base_::swap(x);
+      return;
+    }
+    small_vector temp(*this);
+    *this = x;
+    x = temp;
+  }
+
+  // true while the elements are still in the inline buffer
+  bool is_inline(void) const FT_NOEXCEPT_ { return IsInlineStorage_(); }
+
+ private:
+  bool IsInlineStorage_(void) const FT_NOEXCEPT_ {
+    return this->begin_ == Buffer_::InlineBegin_();
+  }
+};
+
+template <typename T, size_t N, typename Alloc, typename Growth>
+const typename small_vector<T, N, Alloc, Growth>::size_type
+    small_vector<T, N, Alloc, Growth>::inline_capacity;
+
+// SECTION : non-member function overloads (relational operators & swap)
+template <typename T, size_t N, typename Alloc, typename Growth>
+inline bool operator==(const small_vector<T, N, Alloc, Growth>& lhs,
+                       const small_vector<T, N, Alloc, Growth>& rhs) {
+  return (lhs.size() == rhs.size() &&
+          ft::equal(lhs.begin(), lhs.end(), rhs.begin()));
+}
+
+template <typename T, size_t N, typename Alloc, typename Growth>
+inline bool operator!=(const small_vector<T, N, Alloc, Growth>& lhs,
+                       const small_vector<T, N, Alloc, Growth>& rhs) {
+  return !(lhs == rhs);
+}
+
+template <typename T, size_t N, typename Alloc, typename Growth>
+inline bool operator<(const small_vector<T, N, Alloc, Growth>& lhs,
+                      const small_vector<T, N, Alloc, Growth>& rhs) {
+  return ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(),
+                                     rhs.end());
+}
+
+template <typename T, size_t N, typename Alloc, typename Growth>
+inline bool operator<=(const small_vector<T, N, Alloc, Growth>& lhs,
+                       const small_vector<T, N, Alloc, Growth>& rhs) {
+  return !(rhs < lhs);
+}
+
+template <typename T, size_t N, typename Alloc, typename Growth>
+inline bool operator>(const small_vector<T, N, Alloc, Growth>& lhs,
+                      const small_vector<T, N, Alloc, Growth>& rhs) {
+  return rhs < lhs;
+}
+
+template <typename T, size_t N, typename Alloc, typename Growth>
+inline bool operator>=(const small_vector<T, N, Alloc, Growth>& lhs,
+                       const small_vector<T, N, Alloc, Growth>& rhs) {
+  return !(lhs < rhs);
+}
+
+template <typename T, size_t N, typename Alloc, typename Growth>
+inline void swap(small_vector<T, N, Alloc, Growth>& x,
+                 small_vector<T, N, Alloc, Growth>& y) {
+  x.swap(y);
+}
+
+template <typename T, size_t N, typename Alloc, typename Growth,
+          typename Predicate>
+inline typename small_vector<T, N, Alloc, Growth>::size_type erase_if(
+    small_vector<T, N, Alloc, Growth>& c, Predicate pred) {
+  return EraseIf_(c, pred);
+}
+
+}  // namespace ft
+
+#endif
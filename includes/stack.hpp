@@ -8,10 +8,11 @@
 #ifndef FT_CONTAINERS_INCLUDES_STACK_HPP_
 #define FT_CONTAINERS_INCLUDES_STACK_HPP_
 
+#include "deque.hpp"
 #include "vector.hpp"
 
 namespace ft {
-template <typename T, typename Container = vector<T> >
+template <typename T, typename Container = deque<T> >
 class stack {
  public:
   typedef Container container_type;
@@ -1,7 +1,8 @@
 /**
  * @file type_traits.hpp
  * @author ghan (ghan@student.42seoul.kr)
- * @brief Implementations of enable_if, is_integral
+ * @brief Implementations of enable_if, is_integral, is_trivially_copyable,
+ * is_trivially_destructible, has_is_transparent
  * @date 2022-05-26
  */
 
@@ -115,6 +116,79 @@ struct is_const : public false_type {};
 
 template <typename T>
 struct is_const<const T> : public true_type {};
+
+// is_floating_point
+template <typename T>
+struct is_floating_point : public false_type {};
+
+template <>
+struct is_floating_point<float> : public true_type {};
+
+template <>
+struct is_floating_point<double> : public true_type {};
+
+template <>
+struct is_floating_point<long double> : public true_type {};
+
+// is_pointer
+template <typename T>
+struct is_pointer : public false_type {};
+
+template <typename T>
+struct is_pointer<T*> : public true_type {};
+
+// is_scalar (enums and member pointers are not detected)
+template <typename T>
+struct is_scalar
+    : public integral_constant<
+          bool, is_integral<typename remove_cv<T>::type>::value ||
+                    is_floating_point<typename remove_cv<T>::type>::value ||
+                    is_pointer<typename remove_cv<T>::type>::value> {};
+
+// is_trivially_copyable
+// C++98 has no way to tell this from the language itself, so the compiler
+// intrinsic is used when available. Without it, only scalars qualify.
+#if defined(__clang__) || defined(__GNUC__)
+template <typename T>
+struct is_trivially_copyable
+    : public integral_constant<bool, __is_trivially_copyable(T)> {};
+#else
+template <typename T>
+struct is_trivially_copyable : public is_scalar<T> {};
+#endif
+
+// is_trivially_destructible
+// same as above, with the older intrinsic (which C++98 compilers have)
+#if defined(__clang__) || defined(__GNUC__)
+template <typename T>
+struct is_trivially_destructible
+    : public integral_constant<bool, __has_trivial_destructor(T)> {};
+#else
+template <typename T>
+struct is_trivially_destructible : public is_scalar<T> {};
+#endif
+
+// has_is_transparent
+// whether Compare declares is_transparent, i.e. compares keys of other types
+// than its own (see ft::less<>)
+template <typename Compare>
+struct has_is_transparent {
+ private:
+  template <typename U>
+  static char Test(typename U::is_transparent*);
+
+  template <typename U>
+  static long Test(...);
+
+ public:
+  static const bool value = (sizeof(Test<Compare>(0)) == sizeof(char));
+};
+
+// is_reallocating_allocator
+// allocators that can resize a block themselves, without going through
+// allocate / copy / deallocate, specialize this (see mmap_allocator.hpp)
+template <typename Alloc>
+struct is_reallocating_allocator : public false_type {};
 }  // namespace ft
 
 #endif
@@ -1,7 +1,7 @@
 /**
  * @file utility.hpp
  * @author ghan (ghan@student.42seoul.kr)
- * @brief Implementations of pair & make_pair
+ * @brief Implementations of pair, make_pair & less
  * @date 2022-05-27
  */
 
@@ -9,6 +9,13 @@
 #define FT_CONTAINERS_INCLUDES_UTILITY_HPP_
 
 namespace ft {
+// piecewise_construct : tags a pair built from its members' arguments (ft
+// only, one argument for second instead of std's tuples), which lets a map
+// construct its value in place
+struct piecewise_construct_t {};
+
+const piecewise_construct_t piecewise_construct = piecewise_construct_t();
+
 // pair
 template <typename T, typename U>
 struct pair {
@@ -29,6 +36,14 @@ struct pair {
 
   // initialization (3)
   pair(const first_type& a, const second_type& b) : first(a), second(b) {}
+
+  // piecewise (4) (ft only) : second is value-initialized, or built from b
+  // without a second_type temporary
+  pair(piecewise_construct_t, const first_type& a) : first(a), second() {}
+
+  template <typename V>
+  pair(piecewise_construct_t, const first_type& a, const V& b)
+      : first(a), second(b) {}
 };
 
 // pair relational operators
@@ -68,6 +83,36 @@ template <typename T, typename U>
 pair<T, U> make_pair(T x, U y) {
   return pair<T, U>(x, y);
 }
+
+// less
+// less<T> is std::less<T>. less<> (ft only) is transparent : it compares
+// values of any two types with <, and as the comparison of a map or set it
+// enables heterogeneous lookup (e.g. find("key") on std::string keys, without
+// building a std::string).
+template <typename T = void>
+struct less {
+  typedef T first_argument_type;
+  typedef T second_argument_type;
+  typedef bool result_type;
+
+  bool operator()(const T& x, const T& y) const { return x < y; }
+};
+
+template <>
+struct less<void> {
+  typedef void is_transparent;
+
+  template <typename T, typename U>
+  bool operator()(const T& x, const U& y) const {
+    return x < y;
+  }
+};
+
+// sorted_unique : tags a range which is sorted by the container's comparison
+// and holds no equivalent keys (ft only)
+struct sorted_unique_t {};
+
+const sorted_unique_t sorted_unique = sorted_unique_t();
 }  // namespace ft
 
 #endif
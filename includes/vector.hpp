@@ -11,12 +11,15 @@
 #define FT_NOEXCEPT_ throw()
 
 #include <algorithm>
+#include <cstddef>
+#include <cstring>
 #include <exception>
 #include <limits>
 #include <memory>
 
 #include "algorithm.hpp"
 #include "iterator_traits.hpp"
+#include "parallel.hpp"
 #include "type_traits.hpp"
 #include "utility.hpp"
 
@@ -156,6 +159,39 @@ inline typename VectorIterator<IteratorL>::difference_type operator-(
   return lhs.base() - rhs.base();
 }
 
+// SECTION : growth policies
+// NextCapacity returns how many elements to allocate when `required` elements
+// do not fit in `capacity` anymore. The vector never allocates less than
+// `required`, and never more than max_size().
+
+// doubles the capacity : fewest reallocations
+struct GrowthDouble {
+  static size_t NextCapacity(size_t capacity, size_t required, size_t) {
+    return std::max(capacity * 2, required);
+  }
+};
+
+// grows by half : less slack, and freed blocks can be reused by later growth
+struct GrowthOneAndHalf {
+  static size_t NextCapacity(size_t capacity, size_t required, size_t) {
+    return std::max(capacity + capacity / 2, required);
+  }
+};
+
+// doubles the capacity, then rounds the block up to a whole number of pages
+// so that the slack at the end of the last page is usable
+template <size_t PageSize = 4096>
+struct GrowthPageRounded {
+  static size_t NextCapacity(size_t capacity, size_t required,
+                             size_t elem_size) {
+    const size_t next = std::max(capacity * 2, required);
+    if (next > std::numeric_limits<size_t>::max() / elem_size - PageSize)
+      return next;
+    const size_t bytes = (next * elem_size + PageSize - 1) / PageSize * PageSize;
+    return bytes / elem_size;
+  }
+};
+
 // SECTION : vector base class (RAII wrapper)
 template <typename T, typename Alloc = std::allocator<T> >
 class VectorBase {
@@ -172,29 +208,76 @@ class VectorBase {
   pointer end_of_storage_;  // end of alloc
   allocator_type alloc_;    // allocator
 
-  void InitPointers_(const size_type n = 1) {
-    begin_ = alloc_.allocate(n);
+  // an empty block is represented by null pointers, not by an allocation
+  void InitPointers_(const size_type n) {
+    begin_ = (n == 0) ? NULL : alloc_.allocate(n);
     end_ = begin_;
     end_of_storage_ = begin_ + n;
   }
 
-  explicit VectorBase(const allocator_type& alloc = allocator_type())
-      : alloc_(alloc) {
-    InitPointers_();
+  // raw capacity : nothing is constructed in or destroyed from these blocks
+  pointer Allocate_(const size_type n) { return alloc_.allocate(n); }
+
+  void Deallocate_(pointer ptr, const size_type n) {
+    alloc_.deallocate(ptr, n);
+  }
+
+  // resize the block through the allocator itself, the elements travel as
+  // raw bytes (only for trivially copyable types and allocators for which
+  // is_reallocating_allocator is true)
+  void ReallocateStorage_(const size_type n_alloc) {
+    const size_type n_elem = end_ - begin_;
+    if (IsInlineStorage_()) {
+      pointer new_begin = alloc_.allocate(n_alloc);
+      std::memcpy(static_cast<void*>(new_begin),
+                  static_cast<const void*>(begin_), n_elem * sizeof(T));
+      begin_ = new_begin;
+    } else
+      begin_ = alloc_.reallocate(begin_, end_of_storage_ - begin_, n_alloc);
+    end_ = begin_ + n_elem;
+    end_of_storage_ = begin_ + n_alloc;
   }
 
+  // adopt a block that already holds n_elem relocated elements and release
+  // the current one (its elements must have been destroyed)
+  void ReplaceStorage_(pointer new_begin, const size_type n_elem,
+                       const size_type n_alloc) {
+    if (!IsInlineStorage_()) Deallocate_(begin_, end_of_storage_ - begin_);
+    begin_ = new_begin;
+    end_ = new_begin + n_elem;
+    end_of_storage_ = new_begin + n_alloc;
+  }
+
+  // no allocation : begin_ == end_ == end_of_storage_ == NULL, i.e. a full
+  // block of capacity 0, so the first push_back takes the growth path like
+  // any other and no member function needs to check for it
+  explicit VectorBase(const allocator_type& alloc = allocator_type())
+      : begin_(NULL), end_(NULL), end_of_storage_(NULL), alloc_(alloc) {}
+
   explicit VectorBase(const size_type n,
                       const allocator_type& alloc = allocator_type())
       : alloc_(alloc) {
-    (n == 0) ? InitPointers_() : InitPointers_(n);
+    InitPointers_(n);
   }
 
+  // adopt a caller owned buffer of n raw slots (see small_vector.hpp)
+  VectorBase(pointer buffer, const size_type n, const allocator_type& alloc)
+      : begin_(buffer),
+        end_(buffer),
+        end_of_storage_(buffer + n),
+        alloc_(alloc) {}
+
+  // true while the elements live in a buffer the allocator did not provide,
+  // such a block is never handed back to the allocator
+  virtual bool IsInlineStorage_(void) const FT_NOEXCEPT_ { return false; }
+
   virtual ~VectorBase(void) {
     alloc_.deallocate(begin_, end_of_storage_ - begin_);
   }
 };
 
-template <typename T, typename Alloc = std::allocator<T> >
+template <typename T, typename Alloc = std::allocator<T>,
+          typename Growth = GrowthDouble>
 class vector : protected VectorBase<T, Alloc> {
  private:
   typedef VectorBase<T, Alloc> Base_;
@@ -203,6 +286,7 @@ class vector : protected VectorBase<T, Alloc> {
   // SECTION : member types
   typedef T value_type;
   typedef typename Base_::allocator_type allocator_type;
+  typedef Growth growth_policy;
   typedef typename Base_::size_type size_type;
   typedef typename allocator_type::difference_type difference_type;
   typedef typename Base_::pointer pointer;
@@ -215,12 +299,251 @@ class vector : protected VectorBase<T, Alloc> {
   typedef reverse_iterator<iterator> reverse_iterator;
 
  private:
+  // trivially copyable elements are relocated as raw bytes (memcpy/memmove),
+  // everything else goes through the allocator one element at a time
+  typedef typename is_trivially_copyable<value_type>::type Trivial_;
+  // ... and can even be left to the allocator to move, see mmap_allocator.hpp
+  typedef integral_constant<bool, Trivial_::value &&
+                                      is_reallocating_allocator<Alloc>::value>
+      Remappable_;
+
+  // SECTION : relocation utils
+  // Bulk copies, fills and destructions are split across threads when
+  // enabled with set_parallel_execution (see parallel.hpp). Constructions
+  // only for trivially copyable types, which cannot throw half way.
+
+  // copy [first, last) into the uninitialized storage starting at dest
+  pointer RelocateCopy_(const_pointer first, const_pointer last, pointer dest,
+                        true_type) {
+    ParallelCopy_(first, last - first, dest);
+    return dest + (last - first);
+  }
+
+  pointer RelocateCopy_(const_pointer first, const_pointer last, pointer dest,
+                        false_type) {
+    return std::uninitialized_copy(first, last, dest);
+  }
+
+  pointer RelocateCopy_(const_pointer first, const_pointer last,
+                        pointer dest) {
+    return RelocateCopy_(first, last, dest, Trivial_());
+  }
+
+  // construct n copies of val in the uninitialized storage starting at dest
+  void FillN_(pointer dest, size_type n, const value_type& val, true_type) {
+    ParallelFill_(dest, n, val);
+  }
+
+  void FillN_(pointer dest, size_type n, const value_type& val, false_type) {
+    std::uninitialized_fill_n(dest, n, val);
+  }
+
+  void FillN_(pointer dest, size_type n, const value_type& val) {
+    FillN_(dest, n, val, Trivial_());
+  }
+
+  // SECTION : in-place insertion & erasure
+  // Trivially copyable types are shifted with a single memmove. Others copy
+  // construct the part of the tail that lands past end, and shift the rest
+  // with one backward assignment pass, the new elements are then assigned
+  // into the live slots of the gap and constructed in the raw ones.
+
+  // open a gap of n raw slots at position (trivially copyable types only)
+  void OpenGap_(pointer position, size_type n) {
+    std::memmove(static_cast<void*>(position + n),
+                 static_cast<const void*>(position),
+                 (this->end_ - position) * sizeof(value_type));
+    this->end_ += n;
+  }
+
+  // val may refer to an element which is about to be shifted
+  void FillInsert_(pointer position, size_type n, const value_type& val,
+                   true_type) {
+    const value_type val_copy(val);
+    OpenGap_(position, n);
+    std::uninitialized_fill_n(position, n, val_copy);
+  }
+
+  void FillInsert_(pointer position, size_type n, const value_type& val,
+                   false_type) {
+    const value_type val_copy(val);
+    pointer old_end = this->end_;
+    const size_type elems_after = old_end - position;
+    if (elems_after > n) {
+      std::uninitialized_copy(old_end - n, old_end, old_end);
+      this->end_ += n;
+      std::copy_backward(position, old_end - n, old_end);
+      std::fill(position, position + n, val_copy);
+    } else {
+      std::uninitialized_fill_n(old_end, n - elems_after, val_copy);
+      this->end_ += n - elems_after;
+      this->end_ = std::uninitialized_copy(position, old_end, this->end_);
+      std::fill(position, old_end, val_copy);
+    }
+  }
+
+  void FillInsert_(pointer position, size_type n, const value_type& val) {
+    FillInsert_(position, n, val, Trivial_());
+  }
+
+  template <typename ForwardIterator>
+  void CopyInsert_(pointer position, ForwardIterator first,
+                   ForwardIterator last, size_type n, true_type) {
+    OpenGap_(position, n);
+    std::uninitialized_copy(first, last, position);
+  }
+
+  template <typename ForwardIterator>
+  void CopyInsert_(pointer position, ForwardIterator first,
+                   ForwardIterator last, size_type n, false_type) {
+    pointer old_end = this->end_;
+    const size_type elems_after = old_end - position;
+    if (elems_after > n) {
+      std::uninitialized_copy(old_end - n, old_end, old_end);
+      this->end_ += n;
+      std::copy_backward(position, old_end - n, old_end);
+      std::copy(first, last, position);
+    } else {
+      ForwardIterator mid = first;
+      std::advance(mid, elems_after);
+      this->end_ = std::uninitialized_copy(mid, last, old_end);
+      this->end_ = std::uninitialized_copy(position, old_end, this->end_);
+      std::copy(first, mid, position);
+    }
+  }
+
+  template <typename ForwardIterator>
+  void CopyInsert_(pointer position, ForwardIterator first,
+                   ForwardIterator last, size_type n) {
+    CopyInsert_(position, first, last, n, Trivial_());
+  }
+
+  // remove [first, last) by shifting [last, end) onto it
+  void CloseGap_(pointer first, pointer last, true_type) {
+    std::memmove(static_cast<void*>(first), static_cast<const void*>(last),
+                 (this->end_ - last) * sizeof(value_type));
+    this->end_ -= last - first;
+  }
+
+  void CloseGap_(pointer first, pointer last, false_type) {
+    pointer new_end = std::copy(last, this->end_, first);
+    DestroyRange_(new_end, this->end_);
+    this->end_ = new_end;
+  }
+
+  void CloseGap_(pointer first, pointer last) {
+    CloseGap_(first, last, Trivial_());
+  }
+
+  void DestroyRange_(pointer, pointer, true_type) {}
+
+  void DestroyRange_(pointer first, pointer last, false_type) {
+    ParallelDestroy_(first, last - first, this->alloc_);
+  }
+
+  void DestroyRange_(pointer first, pointer last) {
+    DestroyRange_(first, last, Trivial_());
+  }
+
+  // SECTION : reallocation utils
+  size_type NextCapacity_(size_type required) const {
+    if (required > max_size())
+      throw std::length_error("vector cannot grow larger than max_size");
+    const size_type next =
+        Growth::NextCapacity(capacity(), required, sizeof(value_type));
+    return std::min(std::max(next, required), max_size());
+  }
+
+  // relocate [begin, position) and [position, end) around the n slots that
+  // are already constructed at the same offset in new_begin, then adopt the
+  // new block. The old block stays intact until then, so the new elements may
+  // have been copied from it.
+  void RelocateAroundGap_(pointer new_begin, size_type new_cap,
+                          pointer position, size_type n) {
+    pointer gap = new_begin + (position - this->begin_);
+    pointer constructed = gap;
+    try {
+      RelocateCopy_(this->begin_, position, new_begin);
+      constructed = new_begin;
+      RelocateCopy_(position, this->end_, gap + n);
+    } catch (...) {
+      DestroyRange_(constructed, gap + n);
+      this->Deallocate_(new_begin, new_cap);
+      throw;
+    }
+    const size_type new_size = size() + n;
+    DestroyRange_(this->begin_, this->end_);
+    this->ReplaceStorage_(new_begin, new_size, new_cap);
+  }
+
+  // with a reallocating allocator the block is grown first, then the
+  // insertion happens in place
+  void ReallocFillInsert_(pointer position, size_type n, const value_type& val,
+                          true_type) {
+    const value_type val_copy(val);
+    const size_type offset = position - this->begin_;
+    this->ReallocateStorage_(NextCapacity_(size() + n));
+    FillInsert_(this->begin_ + offset, n, val_copy);
+  }
+
+  void ReallocFillInsert_(pointer position, size_type n, const value_type& val,
+                          false_type) {
+    const size_type new_cap = NextCapacity_(size() + n);
+    pointer new_begin = this->Allocate_(new_cap);
+    try {
+      std::uninitialized_fill_n(new_begin + (position - this->begin_), n, val);
+    } catch (...) {
+      this->Deallocate_(new_begin, new_cap);
+      throw;
+    }
+    RelocateAroundGap_(new_begin, new_cap, position, n);
+  }
+
+  void ReallocFillInsert_(pointer position, size_type n,
+                          const value_type& val) {
+    ReallocFillInsert_(position, n, val, Remappable_());
+  }
+
+  template <typename ForwardIterator>
+  void ReallocRangeInsert_(pointer position, ForwardIterator first,
+                           ForwardIterator last, size_type n, true_type) {
+    const size_type offset = position - this->begin_;
+    this->ReallocateStorage_(NextCapacity_(size() + n));
+    CopyInsert_(this->begin_ + offset, first, last, n);
+  }
+
+  template <typename ForwardIterator>
+  void ReallocRangeInsert_(pointer position, ForwardIterator first,
+                           ForwardIterator last, size_type n, false_type) {
+    const size_type new_cap = NextCapacity_(size() + n);
+    pointer new_begin = this->Allocate_(new_cap);
+    try {
+      std::uninitialized_copy(first, last,
+                              new_begin + (position - this->begin_));
+    } catch (...) {
+      this->Deallocate_(new_begin, new_cap);
+      throw;
+    }
+    RelocateAroundGap_(new_begin, new_cap, position, n);
+  }
+
+  template <typename ForwardIterator>
+  void ReallocRangeInsert_(pointer position, ForwardIterator first,
+                           ForwardIterator last, size_type n) {
+    ReallocRangeInsert_(position, first, last, n, Remappable_());
+  }
+
+  void Reserve_(size_type n, true_type) { this->ReallocateStorage_(n); }
+
+  void Reserve_(size_type n, false_type) {
+    RelocateAroundGap_(this->Allocate_(n), n, this->end_, 0);
+  }
+
   template <typename InputIterator>
   void RangeInitialize_(
       InputIterator first,
       typename enable_if<!is_forward_iterator<InputIterator>::value,
                          InputIterator>::type last) {
-    this->InitPointers_();
     for (; first != last; ++first) push_back(*first);
   }
 
@@ -252,9 +575,15 @@ class vector : protected VectorBase<T, Alloc> {
     size_type n =
         static_cast<size_type>(std::distance<InputIterator>(first, last));
     if (n > capacity()) {
-      vector temp(n, value_type(), this->alloc_);
-      temp.end_ = std::uninitialized_copy(first, last, temp.begin()).base();
-      swap(temp);
+      pointer new_begin = this->Allocate_(n);
+      try {
+        std::uninitialized_copy(first, last, new_begin);
+      } catch (...) {
+        this->Deallocate_(new_begin, n);
+        throw;
+      }
+      clear();
+      this->ReplaceStorage_(new_begin, n, n);
     } else {
       clear();
       this->end_ = std::uninitialized_copy(first, last, begin()).base();
@@ -284,32 +613,11 @@ class vector : protected VectorBase<T, Alloc> {
                          InputIterator>::type last) {
     size_type n =
         static_cast<size_type>(std::distance<InputIterator>(first, last));
-    if (pos == end()) {
-      if (size() + n > capacity()) {
-        vector temp(size() + n, value_type(), this->alloc_);
-        temp.clear();
-        temp.end_ =
-            std::uninitialized_copy(begin(), end(), temp.begin()).base();
-        swap(temp);
-      }
-      for (InputIterator itr = first; itr != last; ++itr) push_back(*itr);
-    } else {
-      if (size() + n > capacity()) {
-        vector temp(size() + n, value_type(), this->alloc_);
-        temp.assign(begin(), pos);
-        for (InputIterator itr = first; itr != last; ++itr)
-          temp.push_back(*itr);
-        iterator itre = end();
-        for (iterator itr = pos; itr != itre; ++itr) temp.push_back(*itr);
-        swap(temp);
-      } else {
-        vector temp(pos, end(), this->alloc_);
-        erase(pos, end());
-        for (InputIterator itr = first; itr != last; ++itr) push_back(*itr);
-        iterator itre = temp.end();
-        for (iterator itr = temp.begin(); itr != itre; ++itr) push_back(*itr);
-      }
-    }
+    if (n == 0) return;
+    if (size() + n > capacity())
+      ReallocRangeInsert_(pos.base(), first, last, n);
+    else
+      CopyInsert_(pos.base(), first, last, n);
   }
 
  public:
@@ -322,7 +630,7 @@ class vector : protected VectorBase<T, Alloc> {
   explicit vector(size_type n, const value_type& val = value_type(),
                   const allocator_type& alloc = allocator_type())
       : Base_(n, alloc) {
-    std::uninitialized_fill_n(begin(), n, val);
+    FillN_(this->begin_, n, val);
     this->end_ = this->begin_ + n;
   }
 
@@ -339,12 +647,18 @@ class vector : protected VectorBase<T, Alloc> {
 
   // #4 copy constructor (keeps and uses a copy of x's alloc)
   vector(const vector& x) : Base_(x.size(), x.alloc_) {
-    this->end_ = std::uninitialized_copy(x.begin(), x.end(), begin()).base();
+    this->end_ = RelocateCopy_(x.begin_, x.end_, this->begin_);
   }
 
   // destructor
   ~vector(void) FT_NOEXCEPT_ { clear(); }
 
+ protected:
+  // #5 starts out in a caller owned buffer of n raw slots (small_vector)
+  vector(pointer buffer, size_type n, const allocator_type& alloc)
+      : Base_(buffer, n, alloc) {}
+
+ public:
   // SECTION : operator=
   // preserves the current allocator
   vector& operator=(const vector& x) {
@@ -391,13 +705,11 @@ class vector : protected VectorBase<T, Alloc> {
   }
 
   void resize(size_type n, value_type val = value_type()) {
-    if (n <= size()) {
-      iterator itre = end();
-      for (iterator itr = begin() + n; itr != itre; ++itr)
-        this->alloc_.destroy(itr.base());
-    } else {
+    if (n <= size())
+      DestroyRange_(this->begin_ + n, this->end_);
+    else {
       if (n > capacity()) reserve(n);
-      std::uninitialized_fill_n(end(), n - size(), val);
+      FillN_(this->end_, n - size(), val);
     }
     this->end_ = this->begin_ + n;
   }
@@ -411,11 +723,7 @@ class vector : protected VectorBase<T, Alloc> {
   void reserve(size_type n) {
     if (n > max_size())
       throw std::length_error("cannot reserve capacity larger than max_size");
-    if (n > capacity()) {
-      vector temp(n, value_type(), this->alloc_);
-      temp.end_ = std::uninitialized_copy(begin(), end(), temp.begin()).base();
-      swap(temp);
-    }
+    if (n > capacity()) Reserve_(n, Remappable_());
   }
 
   // SECTION : element access
@@ -447,12 +755,18 @@ class vector : protected VectorBase<T, Alloc> {
   // fill
   void assign(size_type n, const value_type& val) {
     if (n > capacity()) {
-      vector<value_type, allocator_type> temp(n, val, this->alloc_);
-      swap(temp);
+      pointer new_begin = this->Allocate_(n);
+      try {
+        FillN_(new_begin, n, val);
+      } catch (...) {
+        this->Deallocate_(new_begin, n);
+        throw;
+      }
+      clear();
+      this->ReplaceStorage_(new_begin, n, n);
     } else {
       clear();
-      std::uninitialized_fill_n<iterator, size_type, value_type>(begin(), n,
-                                                                 val);
+      FillN_(this->begin_, n, val);
       this->end_ = this->begin_ + n;
     }
   }
@@ -469,13 +783,8 @@ class vector : protected VectorBase<T, Alloc> {
     if (this->end_ != this->end_of_storage_) {
       this->alloc_.construct(this->end_, val);
       ++this->end_;
-    } else {
-      vector temp(size() * 2, value_type(), this->alloc_);
-      temp.assign(begin(), end());
-      temp.alloc_.construct(temp.end_, val);
-      ++temp.end_;
-      swap(temp);
-    }
+    } else
+      ReallocFillInsert_(this->end_, 1, val);
   }
 
   void pop_back(void) FT_NOEXCEPT_ {
@@ -485,60 +794,23 @@ class vector : protected VectorBase<T, Alloc> {
 
   // single element
   iterator insert(iterator position, const value_type& val) {
-    iterator insert_pos = position;
-    if (position == end()) {
+    const size_type offset = position - begin();
+    if (position == end())
       push_back(val);
-      insert_pos = end() - 1;
-    } else {
-      if (size() + 1 > capacity()) {
-        vector temp(size() + 1, value_type(), this->alloc_);
-        temp.assign(begin(), position);
-        insert_pos = temp.end();
-        temp.push_back(val);
-        temp.insert(temp.end(), position, end());
-        swap(temp);
-      } else {
-        ++this->end_;
-        for (reverse_iterator ritr = rbegin(); ritr.base() - 1 != position;
-             ++ritr) {
-          this->alloc_.destroy((ritr.base() - 1).base());
-          this->alloc_.construct((ritr.base() - 1).base(), *(ritr + 1));
-        }
-        this->alloc_.construct(position.base(), val);
-      }
-    }
-    return insert_pos;
+    else if (size() + 1 > capacity())
+      ReallocFillInsert_(position.base(), 1, val);
+    else
+      FillInsert_(position.base(), 1, val);
+    return begin() + offset;
   }
 
   // fill
   void insert(iterator position, size_type n, const value_type& val) {
-    if (position == end()) {
-      if (size() + n > capacity()) {
-        vector temp(size() + n, value_type(), this->alloc_);
-        temp.assign(begin(), end());
-        swap(temp);
-      }
-      for (size_type cnt = 0; cnt < n; ++cnt) push_back(val);
-    } else {
-      if (size() + n > capacity()) {
-        vector temp(size() + n, value_type(), this->alloc_);
-        temp.assign(begin(), position);
-        temp.insert(temp.end(), n, val);
-        temp.insert(temp.end(), position, end());
-        swap(temp);
-      } else {
-        this->end_ += n;
-        for (reverse_iterator ritr = rbegin(); ritr.base() - 1 != position + n;
-             ++ritr) {
-          this->alloc_.destroy((ritr.base() - 1).base());
-          this->alloc_.construct((ritr.base() - 1).base(), *(ritr + 1));
-        }
-        for (iterator itr = position; itr != position + n; ++itr) {
-          this->alloc_.destroy(itr.base());
-          this->alloc_.construct(itr.base(), val);
-        }
-      }
-    }
+    if (n == 0) return;
+    if (size() + n > capacity())
+      ReallocFillInsert_(position.base(), n, val);
+    else
+      FillInsert_(position.base(), n, val);
   }
 
   // range
@@ -551,33 +823,13 @@ class vector : protected VectorBase<T, Alloc> {
 
   // single element
   iterator erase(iterator position) {
-    if (position + 1 == end())
-      pop_back();
-    else {
-      iterator itre = end();
-      for (iterator itr = position; itr + 1 != itre; ++itr) {
-        this->alloc_.destroy(itr.base());
-        this->alloc_.construct(itr.base(), *(itr + 1));
-      }
-      this->end_--;
-    }
+    CloseGap_(position.base(), position.base() + 1);
     return position;
   }
 
   // range
   iterator erase(iterator first, iterator last) {
-    size_type n = 0;
-    size_type move_cnt = 0;
-    for (iterator itr = first; itr != last; ++itr) {
-      this->alloc_.destroy(itr.base());
-      ++n;
-    }
-    for (iterator itr = first; itr + n < end(); ++itr) {
-      if (move_cnt >= n) this->alloc_.destroy(itr.base());
-      this->alloc_.construct(itr.base(), *(itr + n));
-      ++move_cnt;
-    }
-    this->end_ -= n;
+    if (first != last) CloseGap_(first.base(), last.base());
     return first;
   }
 
@@ -593,9 +845,7 @@ class vector : protected VectorBase<T, Alloc> {
   }
 
   void clear(void) FT_NOEXCEPT_ {
-    iterator itre = end();
-    for (iterator itr = begin(); itr != itre; ++itr)
-      this->alloc_.destroy(itr.base());
+    DestroyRange_(this->begin_, this->end_);
     this->end_ = this->begin_;
   }
 
@@ -606,49 +856,79 @@ class vector : protected VectorBase<T, Alloc> {
 };
 
 // SECTION : non-member function overloads (relational operators & swap)
-template <class T, class Alloc>
-inline bool operator==(const vector<T, Alloc>& lhs,
-                       const vector<T, Alloc>& rhs) {
+template <class T, class Alloc, class Growth>
+inline bool operator==(const vector<T, Alloc, Growth>& lhs,
+                       const vector<T, Alloc, Growth>& rhs) {
   return (lhs.size() == rhs.size() &&
           equal(lhs.begin(), lhs.end(), rhs.begin()));
 }
 
-template <class T, class Alloc>
-inline bool operator!=(const vector<T, Alloc>& lhs,
-                       const vector<T, Alloc>& rhs) {
+template <class T, class Alloc, class Growth>
+inline bool operator!=(const vector<T, Alloc, Growth>& lhs,
+                       const vector<T, Alloc, Growth>& rhs) {
   return !(lhs == rhs);
 }
 
-template <class T, class Alloc>
-inline bool operator<(const vector<T, Alloc>& lhs,
-                      const vector<T, Alloc>& rhs) {
+template <class T, class Alloc, class Growth>
+inline bool operator<(const vector<T, Alloc, Growth>& lhs,
+                      const vector<T, Alloc, Growth>& rhs) {
   return lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(),
                                  rhs.end());
 }
 
-template <class T, class Alloc>
-inline bool operator<=(const vector<T, Alloc>& lhs,
-                       const vector<T, Alloc>& rhs) {
+template <class T, class Alloc, class Growth>
+inline bool operator<=(const vector<T, Alloc, Growth>& lhs,
+                       const vector<T, Alloc, Growth>& rhs) {
   return !(rhs < lhs);
 }
 
-template <class T, class Alloc>
-inline bool operator>(const vector<T, Alloc>& lhs,
-                      const vector<T, Alloc>& rhs) {
+template <class T, class Alloc, class Growth>
+inline bool operator>(const vector<T, Alloc, Growth>& lhs,
+                      const vector<T, Alloc, Growth>& rhs) {
   return rhs < lhs;
 }
 
-template <class T, class Alloc>
-inline bool operator>=(const vector<T, Alloc>& lhs,
-                       const vector<T, Alloc>& rhs) {
+template <class T, class Alloc, class Growth>
+inline bool operator>=(const vector<T, Alloc, Growth>& lhs,
+                       const vector<T, Alloc, Growth>& rhs) {
   return !(lhs < rhs);
 }
 
-template <class T, class Alloc>
-inline void swap(vector<T, Alloc>& x, vector<T, Alloc>& y) {
+template <class T, class Alloc, class Growth>
+inline void swap(vector<T, Alloc, Growth>& x, vector<T, Alloc, Growth>& y) {
   x.swap(y);
 }
 
+// SECTION : erase_if
+// removes every element for which pred is true in one linear pass (the kept
+// ones are compacted to the front, then the tail is erased at once), returns
+// the number of removed elements
+template <typename Container, typename Predicate>
+typename Container::size_type EraseIf_(Container& c, Predicate pred) {
+  typedef typename Container::iterator iterator;
+  iterator first = c.begin();
+  iterator last = c.end();
+  while (first != last && !pred(*first)) ++first;
+  iterator result = first;
+  if (first != last)
+    for (++first; first != last; ++first)
+      if (!pred(*first)) {
+        *result = *first;
+        ++result;
+      }
+  const typename Container::size_type removed = last - result;
+  c.erase(result, last);
+  return removed;
+}
+
+template <class T, class Alloc, class Growth, class Predicate>
+inline typename vector<T, Alloc, Growth>::size_type erase_if(
+    vector<T, Alloc, Growth>& c, Predicate pred) {
+  return EraseIf_(c, pred);
+}
+
 }  // namespace ft
 
+#include "vector_bool.hpp"
+
 #endif
@@ -0,0 +1,709 @@
+/**
+ * @file vector_bool.hpp
+ * @author ghan (ghan@student.42seoul.kr)
+ * @brief A header file for the packed vector<bool> specialization
+ * @date 2022-07-18
+ */
+
+#ifndef FT_CONTAINERS_INCLUDES_VECTOR_BOOL_HPP_
+#define FT_CONTAINERS_INCLUDES_VECTOR_BOOL_HPP_
+
+#define FT_NOEXCEPT_ throw()
+
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+
+#include "algorithm.hpp"
+#include "iterator_traits.hpp"
+#include "type_traits.hpp"
+#include "vector.hpp"
+
+namespace ft {
+
+// SECTION : bit words
+// bits are packed in unsigned long words, bit i of the vector is bit
+// (i % kBitsPerWord) of word (i / kBitsPerWord)
+typedef unsigned long BitWord;
+
+static const size_t kBitsPerWord = CHAR_BIT * sizeof(BitWord);
+
+inline size_t PopCount_(BitWord word) {
+#if defined(__clang__) || defined(__GNUC__)
+  return __builtin_popcountl(word);
+#else
+  size_t count = 0;
+  for (; word; word &= word - 1) ++count;
+  return count;
+#endif
+}
+
+// word must not be 0
+inline size_t CountTrailingZeros_(BitWord word) {
+#if defined(__clang__) || defined(__GNUC__)
+  return __builtin_ctzl(word);
+#else
+  size_t count = 0;
+  for (; !(word & 1); word >>= 1) ++count;
+  return count;
+#endif
+}
+
+// SECTION : reference proxy
+// a bit cannot be addressed, vector<bool>::reference stands for one
+class BitReference {
+ private:
+  BitWord* word_;
+  BitWord mask_;
+
+ public:
+  BitReference(BitWord* word, size_t offset)
+      : word_(word), mask_(BitWord(1) << offset) {}
+
+  BitReference(void) : word_(NULL), mask_(0) {}
+
+  operator bool(void) const { return (*word_ & mask_) != 0; }
+
+  BitReference& operator=(bool val) {
+    if (val)
+      *word_ |= mask_;
+    else
+      *word_ &= ~mask_;
+    return *this;
+  }
+
+  // assigns the value, not the reference
+  BitReference& operator=(const BitReference& rhs) {
+    return *this = static_cast<bool>(rhs);
+  }
+
+  bool operator~(void) const { return !static_cast<bool>(*this); }
+
+  void flip(void) { *word_ ^= mask_; }
+};
+
+// SECTION : bit iterator classes
+// implementation of random access iterators for ft::vector<bool>, a word and
+// a bit offset in it
+class BitIteratorBase {
+ protected:
+  BitWord* word_;
+  size_t offset_;
+
+  BitIteratorBase(BitWord* word, size_t offset)
+      : word_(word), offset_(offset) {}
+
+  void Increment_(void) {
+    if (offset_++ == kBitsPerWord - 1) {
+      offset_ = 0;
+      ++word_;
+    }
+  }
+
+  void Decrement_(void) {
+    if (offset_-- == 0) {
+      offset_ = kBitsPerWord - 1;
+      --word_;
+    }
+  }
+
+  void Advance_(ptrdiff_t n) {
+    ptrdiff_t bit = n + static_cast<ptrdiff_t>(offset_);
+    word_ += bit / static_cast<ptrdiff_t>(kBitsPerWord);
+    bit %= static_cast<ptrdiff_t>(kBitsPerWord);
+    if (bit < 0) {
+      bit += kBitsPerWord;
+      --word_;
+    }
+    offset_ = static_cast<size_t>(bit);
+  }
+
+ public:
+  typedef random_access_iterator_tag iterator_category;
+  typedef bool value_type;
+  typedef ptrdiff_t difference_type;
+
+  BitWord* word(void) const { return word_; }
+
+  size_t offset(void) const { return offset_; }
+};
+
+inline bool operator==(const BitIteratorBase& lhs, const BitIteratorBase& rhs) {
+  return lhs.word() == rhs.word() && lhs.offset() == rhs.offset();
+}
+
+inline bool operator!=(const BitIteratorBase& lhs, const BitIteratorBase& rhs) {
+  return !(lhs == rhs);
+}
+
+inline bool operator<(const BitIteratorBase& lhs, const BitIteratorBase& rhs) {
+  return lhs.word() < rhs.word() ||
+         (lhs.word() == rhs.word() && lhs.offset() < rhs.offset());
+}
+
+inline bool operator>(const BitIteratorBase& lhs, const BitIteratorBase& rhs) {
+  return rhs < lhs;
+}
+
+inline bool operator<=(const BitIteratorBase& lhs, const BitIteratorBase& rhs) {
+  return !(rhs < lhs);
+}
+
+inline bool operator>=(const BitIteratorBase& lhs, const BitIteratorBase& rhs) {
+  return !(lhs < rhs);
+}
+
+inline ptrdiff_t operator-(const BitIteratorBase& lhs,
+                           const BitIteratorBase& rhs) {
+  return static_cast<ptrdiff_t>(kBitsPerWord) * (lhs.word() - rhs.word()) +
+         static_cast<ptrdiff_t>(lhs.offset()) -
+         static_cast<ptrdiff_t>(rhs.offset());
+}
+
+class BitIterator : public BitIteratorBase {
+ public:
+  typedef BitReference reference;
+  typedef BitReference* pointer;
+
+  // Constructors
+  BitIterator(void) : BitIteratorBase(NULL, 0) {}
+
+  BitIterator(BitWord* word, size_t offset) : BitIteratorBase(word, offset) {}
+
+  // dereference & reference
+  reference operator*(void) const { return reference(word_, offset_); }
+
+  reference operator[](difference_type n) const { return *(*this + n); }
+
+  // increment & decrement
+  BitIterator& operator++(void) {
+    Increment_();
+    return *this;
+  }
+
+  BitIterator operator++(int) {
+    BitIterator tmp = *this;
+    Increment_();
+    return tmp;
+  }
+
+  BitIterator& operator--(void) {
+    Decrement_();
+    return *this;
+  }
+
+  BitIterator operator--(int) {
+    BitIterator tmp = *this;
+    Decrement_();
+    return tmp;
+  }
+
+  // add or subtract difference
+  BitIterator& operator+=(difference_type n) {
+    Advance_(n);
+    return *this;
+  }
+
+  BitIterator& operator-=(difference_type n) {
+    Advance_(-n);
+    return *this;
+  }
+
+  BitIterator operator+(difference_type n) const {
+    BitIterator tmp = *this;
+    return tmp += n;
+  }
+
+  BitIterator operator-(difference_type n) const {
+    BitIterator tmp = *this;
+    return tmp -= n;
+  }
+};
+
+inline BitIterator operator+(ptrdiff_t n, const BitIterator& itr) {
+  return itr + n;
+}
+
+class BitConstIterator : public BitIteratorBase {
+ public:
+  typedef bool reference;
+  typedef const bool* pointer;
+
+  // Constructors
+  BitConstIterator(void) : BitIteratorBase(NULL, 0) {}
+
+  BitConstIterator(BitWord* word, size_t offset)
+      : BitIteratorBase(word, offset) {}
+
+  BitConstIterator(const BitIterator& itr)
+      : BitIteratorBase(itr.word(), itr.offset()) {}
+
+  // dereference & reference
+  reference operator*(void) const {
+    return (*word_ & (BitWord(1) << offset_)) != 0;
+  }
+
+  reference operator[](difference_type n) const { return *(*this + n); }
+
+  // increment & decrement
+  BitConstIterator& operator++(void) {
+    Increment_();
+    return *this;
+  }
+
+  BitConstIterator operator++(int) {
+    BitConstIterator tmp = *this;
+    Increment_();
+    return tmp;
+  }
+
+  BitConstIterator& operator--(void) {
+    Decrement_();
+    return *this;
+  }
+
+  BitConstIterator operator--(int) {
+    BitConstIterator tmp = *this;
+    Decrement_();
+    return tmp;
+  }
+
+  // add or subtract difference
+  BitConstIterator& operator+=(difference_type n) {
+    Advance_(n);
+    return *this;
+  }
+
+  BitConstIterator& operator-=(difference_type n) {
+    Advance_(-n);
+    return *this;
+  }
+
+  BitConstIterator operator+(difference_type n) const {
+    BitConstIterator tmp = *this;
+    return tmp += n;
+  }
+
+  BitConstIterator operator-(difference_type n) const {
+    BitConstIterator tmp = *this;
+    return tmp -= n;
+  }
+};
+
+inline BitConstIterator operator+(ptrdiff_t n, const BitConstIterator& itr) {
+  return itr + n;
+}
+
+// SECTION : vector<bool>
+// One bit per element, stored in a vector of words (which brings its growth
+// policy along). The bits past size() in the last word are always 0, so that
+// count, find and comparisons can work a word at a time.
+template <typename Alloc, typename Growth>
+class vector<bool, Alloc, Growth> {
+ private:
+  typedef typename Alloc::template rebind<BitWord>::other WordAlloc_;
+  typedef vector<BitWord, WordAlloc_, Growth> Words_;
+
+ public:
+  // SECTION : member types
+  typedef bool value_type;
+  typedef Alloc allocator_type;
+  typedef Growth growth_policy;
+  typedef size_t size_type;
+  typedef ptrdiff_t difference_type;
+  typedef BitReference reference;
+  typedef bool const_reference;
+  typedef BitReference* pointer;
+  typedef const bool* const_pointer;
+  typedef BitIterator iterator;
+  typedef BitConstIterator const_iterator;
+  typedef reverse_iterator<const_iterator> const_reverse_iterator;
+  typedef reverse_iterator<iterator> reverse_iterator;
+
+  // returned by find_first / find_next when there is no set bit
+  static const size_type npos = static_cast<size_type>(-1);
+
+ private:
+  Words_ words_;
+  size_type size_;
+
+  static size_type WordCount_(size_type n_bits) {
+    return (n_bits + kBitsPerWord - 1) / kBitsPerWord;
+  }
+
+  BitWord* WordsBegin_(void) const {
+    return const_cast<BitWord*>(words_.begin().base());
+  }
+
+  void SetBit_(size_type pos, bool val) {
+    const BitWord mask = BitWord(1) << (pos % kBitsPerWord);
+    if (val)
+      words_[pos / kBitsPerWord] |= mask;
+    else
+      words_[pos / kBitsPerWord] &= ~mask;
+  }
+
+  // [first, last) to val, whole words at once in the middle
+  void FillBits_(size_type first, size_type last, bool val) {
+    for (; first != last && first % kBitsPerWord != 0; ++first)
+      SetBit_(first, val);
+    for (; last - first >= kBitsPerWord; first += kBitsPerWord)
+      words_[first / kBitsPerWord] = val ? ~BitWord(0) : BitWord(0);
+    for (; first != last; ++first) SetBit_(first, val);
+  }
+
+  // zero the bits past size_ in the last word
+  void ClearTail_(void) {
+    const size_type used = size_ % kBitsPerWord;
+    if (used != 0) words_.back() &= (BitWord(1) << used) - 1;
+  }
+
+  // n new bits at the end, left uninitialized (but 0)
+  void Grow_(size_type n) {
+    if (n > max_size() - size_)
+      throw std::length_error("vector<bool> cannot grow larger than max_size");
+    words_.resize(WordCount_(size_ + n), BitWord(0));
+    size_ += n;
+  }
+
+  void Shrink_(size_type n) {
+    size_ = n;
+    words_.resize(WordCount_(n));
+    ClearTail_();
+  }
+
+  // n bits are opened at offset, the following ones shift up
+  void OpenGap_(size_type offset, size_type n) {
+    const size_type old_size = size_;
+    Grow_(n);
+    std::copy_backward(begin() + offset, begin() + old_size, end());
+  }
+
+  template <typename InputIterator>
+  void RangeInsert_(
+      size_type offset, InputIterator first,
+      typename enable_if<!is_forward_iterator<InputIterator>::value,
+                         InputIterator>::type last) {
+    for (; first != last; ++first, ++offset) insert(begin() + offset, *first);
+  }
+
+  template <typename ForwardIterator>
+  void RangeInsert_(
+      size_type offset, ForwardIterator first,
+      typename enable_if<is_forward_iterator<ForwardIterator>::value,
+                         ForwardIterator>::type last) {
+    const size_type n =
+        static_cast<size_type>(std::distance<ForwardIterator>(first, last));
+    if (n == 0) return;
+    OpenGap_(offset, n);
+    std::copy(first, last, begin() + offset);
+  }
+
+  void CheckSameSize_(const vector& x) const {
+    if (size_ != x.size_)
+      throw std::invalid_argument("vector<bool> sizes do not match");
+  }
+
+ public:
+  // SECTION : constructors & destructor
+  // #1 default : empty container constructor (no elem)
+  explicit vector(const allocator_type& alloc = allocator_type())
+      : words_(WordAlloc_(alloc)), size_(0) {}
+
+  // #2 fill : construct a container with n elements, fill them with val
+  explicit vector(size_type n, const value_type& val = value_type(),
+                  const allocator_type& alloc = allocator_type())
+      : words_(WordCount_(n), val ? ~BitWord(0) : BitWord(0),
+               WordAlloc_(alloc)),
+        size_(n) {
+    ClearTail_();
+  }
+
+  // #3 range : construct a container with the values in [first, last)
+  template <typename InputIterator>
+  vector(InputIterator first,
+         typename enable_if<is_input_iterator<InputIterator>::value,
+                            InputIterator>::type last,
+         const allocator_type& alloc = allocator_type())
+      : words_(WordAlloc_(alloc)), size_(0) {
+    RangeInsert_(0, first, last);
+  }
+
+  // #4 copy constructor
+  vector(const vector& x) : words_(x.words_), size_(x.size_) {}
+
+  // destructor
+  ~vector(void) FT_NOEXCEPT_ {}
+
+  // SECTION : operator=
+  vector& operator=(const vector& x) {
+    words_ = x.words_;
+    size_ = x.size_;
+    return *this;
+  }
+
+  // SECTION : iterators
+  iterator begin(void) FT_NOEXCEPT_ { return iterator(WordsBegin_(), 0); }
+
+  const_iterator begin(void) const FT_NOEXCEPT_ {
+    return const_iterator(WordsBegin_(), 0);
+  }
+
+  iterator end(void) FT_NOEXCEPT_ {
+    return iterator(WordsBegin_() + size_ / kBitsPerWord,
+                    size_ % kBitsPerWord);
+  }
+
+  const_iterator end(void) const FT_NOEXCEPT_ {
+    return const_iterator(WordsBegin_() + size_ / kBitsPerWord,
+                          size_ % kBitsPerWord);
+  }
+
+  reverse_iterator rbegin(void) FT_NOEXCEPT_ { return reverse_iterator(end()); }
+
+  const_reverse_iterator rbegin(void) const FT_NOEXCEPT_ {
+    return const_reverse_iterator(end());
+  }
+
+  reverse_iterator rend(void) FT_NOEXCEPT_ { return reverse_iterator(begin()); }
+
+  const_reverse_iterator rend(void) const FT_NOEXCEPT_ {
+    return const_reverse_iterator(begin());
+  }
+
+  // SECTION : capacity
+  size_type size(void) const FT_NOEXCEPT_ { return size_; }
+
+  size_type max_size(void) const FT_NOEXCEPT_ {
+    const size_type word_max = words_.max_size();
+    if (word_max > std::numeric_limits<size_type>::max() / kBitsPerWord)
+      return std::numeric_limits<size_type>::max();
+    return word_max * kBitsPerWord;
+  }
+
+  void resize(size_type n, value_type val = value_type()) {
+    if (n <= size_)
+      Shrink_(n);
+    else {
+      const size_type old_size = size_;
+      Grow_(n - old_size);
+      if (val) FillBits_(old_size, n, true);
+    }
+  }
+
+  size_type capacity(void) const FT_NOEXCEPT_ {
+    return words_.capacity() * kBitsPerWord;
+  }
+
+  bool empty(void) const FT_NOEXCEPT_ { return size_ == 0; }
+
+  void reserve(size_type n) {
+    if (n > max_size())
+      throw std::length_error("cannot reserve capacity larger than max_size");
+    words_.reserve(WordCount_(n));
+  }
+
+  // SECTION : element access
+  reference operator[](size_type n) FT_NOEXCEPT_ {
+    return reference(WordsBegin_() + n / kBitsPerWord, n % kBitsPerWord);
+  }
+
+  const_reference operator[](size_type n) const FT_NOEXCEPT_ {
+    return (words_[n / kBitsPerWord] >> (n % kBitsPerWord)) & 1;
+  }
+
+  reference at(size_type n) {
+    if (n >= size()) throw std::out_of_range("exceeds the vector's size");
+    return (*this)[n];
+  }
+
+  const_reference at(size_type n) const {
+    if (n >= size()) throw std::out_of_range("exceeds the vector's size");
+    return (*this)[n];
+  }
+
+  reference front(void) FT_NOEXCEPT_ { return *begin(); }
+
+  const_reference front(void) const FT_NOEXCEPT_ { return *begin(); }
+
+  reference back(void) FT_NOEXCEPT_ { return *(end() - 1); }
+
+  const_reference back(void) const FT_NOEXCEPT_ { return *(end() - 1); }
+
+  // SECTION : modifiers
+  // fill
+  void assign(size_type n, const value_type& val) {
+    words_.assign(WordCount_(n), val ? ~BitWord(0) : BitWord(0));
+    size_ = n;
+    ClearTail_();
+  }
+
+  // range
+  template <typename InputIterator>
+  void assign(InputIterator first,
+              typename enable_if<is_input_iterator<InputIterator>::value,
+                                 InputIterator>::type last) {
+    clear();
+    RangeInsert_(0, first, last);
+  }
+
+  void push_back(const value_type& val) {
+    if (size_ % kBitsPerWord == 0) words_.push_back(BitWord(0));
+    if (val) SetBit_(size_, true);
+    ++size_;
+  }
+
+  void pop_back(void) FT_NOEXCEPT_ {
+    --size_;
+    SetBit_(size_, false);
+    if (size_ % kBitsPerWord == 0) words_.pop_back();
+  }
+
+  // single element
+  iterator insert(iterator position, const value_type& val) {
+    const size_type offset = position - begin();
+    if (offset == size_)
+      push_back(val);
+    else {
+      OpenGap_(offset, 1);
+      SetBit_(offset, val);
+    }
+    return begin() + offset;
+  }
+
+  // fill
+  void insert(iterator position, size_type n, const value_type& val) {
+    const size_type offset = position - begin();
+    if (n == 0) return;
+    OpenGap_(offset, n);
+    FillBits_(offset, offset + n, val);
+  }
+
+  // range
+  template <typename InputIterator>
+  void insert(iterator position, InputIterator first,
+              typename enable_if<is_input_iterator<InputIterator>::value,
+                                 InputIterator>::type last) {
+    RangeInsert_(position - begin(), first, last);
+  }
+
+  // single element
+  iterator erase(iterator position) { return erase(position, position + 1); }
+
+  // range
+  iterator erase(iterator first, iterator last) {
+    const size_type offset = first - begin();
+    if (first != last) Shrink_(std::copy(last, end(), first) - begin());
+    return begin() + offset;
+  }
+
+  void swap(vector& x) {
+    words_.swap(x.words_);
+    std::swap(size_, x.size_);
+  }
+
+  // swap two bits (of this or any other vector<bool>)
+  static void swap(reference x, reference y) {
+    const bool tmp = x;
+    x = y;
+    y = tmp;
+  }
+
+  void clear(void) FT_NOEXCEPT_ {
+    words_.clear();
+    size_ = 0;
+  }
+
+  // toggles every bit
+  void flip(void) FT_NOEXCEPT_ {
+    for (typename Words_::iterator it = words_.begin(); it != words_.end();
+         ++it)
+      *it = ~*it;
+    ClearTail_();
+  }
+
+  // SECTION : bitwise operations (a word at a time)
+  // number of set bits
+  size_type count(void) const FT_NOEXCEPT_ {
+    size_type n = 0;
+    for (typename Words_::const_iterator it = words_.begin();
+         it != words_.end(); ++it)
+      n += PopCount_(*it);
+    return n;
+  }
+
+  // position of the first set bit, npos if none
+  size_type find_first(void) const FT_NOEXCEPT_ { return FindFrom_(0); }
+
+  // position of the first set bit after pos, npos if none
+  size_type find_next(size_type pos) const FT_NOEXCEPT_ {
+    return (pos + 1 >= size_) ? npos : FindFrom_(pos + 1);
+  }
+
+  // the operands must have the same size
+  vector& operator&=(const vector& x) {
+    CheckSameSize_(x);
+    for (size_type i = 0; i < words_.size(); ++i) words_[i] &= x.words_[i];
+    return *this;
+  }
+
+  vector& operator|=(const vector& x) {
+    CheckSameSize_(x);
+    for (size_type i = 0; i < words_.size(); ++i) words_[i] |= x.words_[i];
+    return *this;
+  }
+
+  vector& operator^=(const vector& x) {
+    CheckSameSize_(x);
+    for (size_type i = 0; i < words_.size(); ++i) words_[i] ^= x.words_[i];
+    return *this;
+  }
+
+  // SECTION : allocator
+  allocator_type get_allocator(void) const FT_NOEXCEPT_ {
+    return allocator_type(words_.get_allocator());
+  }
+
+  // same size and, the tails being 0, same words
+  friend bool operator==(const vector& lhs, const vector& rhs) {
+    return lhs.size_ == rhs.size_ &&
+           ft::equal(lhs.words_.begin(), lhs.words_.end(), rhs.words_.begin());
+  }
+
+ private:
+  size_type FindFrom_(size_type pos) const FT_NOEXCEPT_ {
+    size_type word_idx = pos / kBitsPerWord;
+    if (word_idx >= words_.size()) return npos;
+    BitWord word = words_[word_idx] & (~BitWord(0) << (pos % kBitsPerWord));
+    while (word == 0) {
+      if (++word_idx == words_.size()) return npos;
+      word = words_[word_idx];
+    }
+    return word_idx * kBitsPerWord + CountTrailingZeros_(word);
+  }
+};
+
+template <typename Alloc, typename Growth>
+const typename vector<bool, Alloc, Growth>::size_type
+    vector<bool, Alloc, Growth>::npos;
+
+// SECTION : non-member function overloads (relational operators)
+template <typename Alloc, typename Growth>
+inline bool operator!=(const vector<bool, Alloc, Growth>& lhs,
+                       const vector<bool, Alloc, Growth>& rhs) {
+  return !(lhs == rhs);
+}
+
+template <typename Alloc, typename Growth>
+inline bool operator<(const vector<bool, Alloc, Growth>& lhs,
+                      const vector<bool, Alloc, Growth>& rhs) {
+  return ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(),
+                                     rhs.end());
+}
+
+}  // namespace ft
+
+#endif
@@ -0,0 +1,909 @@
+#include <pthread.h>
+#include <sys/time.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <set>
+#include <sstream>
+#include <string>
+
+#include <btree_map.hpp>
+#include <btree_set.hpp>
+#include <concurrent_map.hpp>
+#include <deque.hpp>
+#include <flat_map.hpp>
+#include <flat_set.hpp>
+#include <map.hpp>
+#include <mapped_vector.hpp>
+#include <parallel.hpp>
+#include <set.hpp>
+#include <small_vector.hpp>
+#include <stack.hpp>
+#include <vector.hpp>
+
+// SECTION : timing utils
+class Stopwatch {
+ public:
+  Stopwatch(void) { gettimeofday(&start_, NULL); }
+
+  // milliseconds since construction
+  double Elapsed(void) const {
+    struct timeval now;
+    gettimeofday(&now, NULL);
+    return (now.tv_sec - start_.tv_sec) * 1000.0 +
+           (now.tv_usec - start_.tv_usec) / 1000.0;
+  }
+
+ private:
+  struct timeval start_;
+};
+
+// keeps the optimizer from dropping the measured work
+static volatile size_t g_sink;
+
+void PrintHeader(const std::string& title) {
+  std::cout << "\n" << title << "\n\n";
+}
+
+void PrintRow(const std::string& label, double ms) {
+  std::cout << "  " << std::left << std::setw(40) << label << std::right
+            << std::setw(10) << std::fixed << std::setprecision(2) << ms
+            << " ms\n";
+}
+
+void PrintFooter(void) {
+  std::cout << "\n========================================\n";
+}
+
+// SECTION : small_vector vs vector
+template <typename Vector>
+double FillAndDrop(size_t n_elem, size_t rounds) {
+  Stopwatch sw;
+  size_t sum = 0;
+  for (size_t r = 0; r < rounds; ++r) {
+    Vector v;
+    for (size_t i = 0; i < n_elem; ++i) v.push_back(static_cast<int>(i));
+    sum += v.size();
+  }
+  g_sink = sum;
+  return sw.Elapsed();
+}
+
+void BenchSmallVector(void) {
+  const size_t rounds = 1000000;
+  PrintHeader("SMALL_VECTOR<int, 16> VS VECTOR<int> (1M x push_back n)");
+  for (size_t n = 0; n <= 16; n += 4) {
+    std::ostringstream label;
+    label << "n = " << n;
+    PrintRow("vector       " + label.str(),
+             FillAndDrop<ft::vector<int> >(n, rounds));
+    PrintRow("small_vector " + label.str(),
+             FillAndDrop<ft::small_vector<int, 16> >(n, rounds));
+  }
+  PrintFooter();
+}
+
+// SECTION : parallel fill, copy & destroy
+// same element type as srcs/main.cpp
+struct Buffer {
+  int idx;
+  char buff[4096];
+};
+
+void BenchParallel(void) {
+  const size_t n_elem = 1 << 15;  // 128 MiB of Buffer
+  const size_t thread_counts[] = {1, 2, 4, 8};
+  PrintHeader("PARALLEL EXECUTION (32768 x Buffer, 131072 x std::string)");
+  for (size_t i = 0; i < sizeof(thread_counts) / sizeof(size_t); ++i) {
+    ft::set_parallel_execution(thread_counts[i], 1024);
+    std::ostringstream label;
+    label << thread_counts[i] << " thread(s)";
+
+    ft::vector<Buffer> src;
+    Stopwatch fill_sw;
+    src.assign(n_elem, Buffer());
+    PrintRow("assign(n, val)  " + label.str(), fill_sw.Elapsed());
+
+    Stopwatch copy_sw;
+    ft::vector<Buffer> copy(src);
+    PrintRow("copy            " + label.str(), copy_sw.Elapsed());
+    g_sink = copy.size();
+
+    ft::vector<Buffer> grown;
+    Stopwatch resize_sw;
+    grown.resize(n_elem);
+    PrintRow("resize          " + label.str(), resize_sw.Elapsed());
+    g_sink = grown.size();
+
+    // heap allocated strings : destruction is not a no-op
+    ft::vector<std::string> strs(4 * n_elem,
+                                 std::string("long enough to be on the heap"));
+    Stopwatch clear_sw;
+    strs.clear();
+    PrintRow("clear (string)  " + label.str(), clear_sw.Elapsed());
+  }
+  ft::set_parallel_execution(1);
+  PrintFooter();
+}
+
+// SECTION : deque vs vector backed stack
+template <typename Stack>
+double PushAndPop(size_t n_elem) {
+  Stopwatch sw;
+  Stack st;
+  Buffer buffer;
+  for (size_t i = 0; i < n_elem; ++i) {
+    buffer.idx = static_cast<int>(i);
+    st.push(buffer);
+  }
+  size_t sum = 0;
+  for (; !st.empty(); st.pop()) sum += st.top().idx;
+  g_sink = sum;
+  return sw.Elapsed();
+}
+
+void BenchDequeStack(void) {
+  PrintHeader("STACK<Buffer> : DEQUE VS VECTOR (push n, then pop all)");
+  for (size_t n = 1 << 12; n <= (1 << 16); n <<= 2) {
+    std::ostringstream label;
+    label << "n = " << n;
+    PrintRow("deque  " + label.str(),
+             PushAndPop<ft::stack<Buffer, ft::deque<Buffer> > >(n));
+    PrintRow("vector " + label.str(),
+             PushAndPop<ft::stack<Buffer, ft::vector<Buffer> > >(n));
+  }
+  PrintFooter();
+}
+
+// SECTION : mapped_vector warm restart
+void BenchMappedVector(void) {
+  const char* path = "bench_mapped_vector.ftmv";
+  const size_t n_elem = 1 << 24;  // 64 MiB of int
+  std::remove(path);
+  {
+    ft::mapped_vector<int> mv(path);
+    mv.resize(n_elem);
+    for (size_t i = 0; i < n_elem; ++i) mv[i] = static_cast<int>(i);
+  }
+  PrintHeader("RELOAD 16M INTS : FREAD + PUSH_BACK VS MAPPED_VECTOR");
+  {
+    Stopwatch sw;
+    ft::vector<int> v;
+    FILE* file = std::fopen(path, "rb");
+    std::fseek(file, ft::mapped_vector<int>::header_size, SEEK_SET);
+    int chunk[1024];
+    size_t n_read;
+    while ((n_read = std::fread(chunk, sizeof(int), 1024, file)) > 0)
+      for (size_t i = 0; i < n_read; ++i) v.push_back(chunk[i]);
+    std::fclose(file);
+    g_sink = v.size();
+    PrintRow("vector, fread + push_back", sw.Elapsed());
+  }
+  {
+    Stopwatch sw;
+    ft::mapped_vector<int> mv(path);
+    g_sink = mv.size() + mv.back();
+    PrintRow("mapped_vector, open", sw.Elapsed());
+    Stopwatch scan_sw;
+    size_t sum = 0;
+    for (ft::mapped_vector<int>::iterator it = mv.begin(); it != mv.end();
+         ++it)
+      sum += *it;
+    g_sink = sum;
+    PrintRow("mapped_vector, first full scan", scan_sw.Elapsed());
+  }
+  std::remove(path);
+  PrintFooter();
+}
+
+// SECTION : map node pool
+// the same pseudo-random keys for every map
+template <typename Map>
+void InsertAndErase(size_t n_elem, bool reserve, double* insert_ms,
+                    double* erase_ms) {
+  Map m;
+  Stopwatch insert_sw;
+  if (reserve) m.reserve(n_elem);
+  for (size_t i = 0; i < n_elem; ++i)
+    m.insert(typename Map::value_type(static_cast<int>((i * 2654435761u) %
+                                                       n_elem),
+                                      static_cast<int>(i)));
+  *insert_ms = insert_sw.Elapsed();
+  Stopwatch erase_sw;
+  for (size_t i = 0; i < n_elem; ++i)
+    m.erase(static_cast<int>((i * 2654435761u) % n_elem));
+  *erase_ms = erase_sw.Elapsed();
+  g_sink = m.size();
+}
+
+// std::map has no reserve
+struct StdMap : public std::map<int, int> {
+  void reserve(size_t) {}
+};
+
+void BenchNodePool(void) {
+  const size_t n_elem = 1 << 20;
+  double insert_ms;
+  double erase_ms;
+  PrintHeader("MAP<int, int> : 1M INSERTS, THEN 1M ERASES");
+  std::cout << "  node size : "
+            << sizeof(ft::RbTreeNode<ft::pair<const int, int> >)
+            << " bytes\n\n";
+  InsertAndErase<StdMap>(n_elem, false, &insert_ms, &erase_ms);
+  PrintRow("std::map, insert", insert_ms);
+  PrintRow("std::map, erase", erase_ms);
+  InsertAndErase<ft::map<int, int> >(n_elem, false, &insert_ms, &erase_ms);
+  PrintRow("ft::map (node pool), insert", insert_ms);
+  PrintRow("ft::map (node pool), erase", erase_ms);
+  InsertAndErase<ft::map<int, int> >(n_elem, true, &insert_ms, &erase_ms);
+  PrintRow("ft::map (reserved), insert", insert_ms);
+  PrintRow("ft::map (reserved), erase", erase_ms);
+  PrintFooter();
+}
+
+// SECTION : map copy
+template <typename Map>
+void CopyAndAssign(size_t n_elem, double* copy_ms, double* assign_ms) {
+  Map src;
+  Map dest;
+  for (size_t i = 0; i < n_elem; ++i) {
+    src.insert(typename Map::value_type(static_cast<int>(i), 0));
+    dest.insert(typename Map::value_type(static_cast<int>(n_elem - i), 1));
+  }
+  Stopwatch copy_sw;
+  Map copy(src);
+  *copy_ms = copy_sw.Elapsed();
+  Stopwatch assign_sw;
+  dest = src;
+  *assign_ms = assign_sw.Elapsed();
+  g_sink = copy.size() + dest.size();
+}
+
+void BenchMapCopy(void) {
+  const size_t n_elem = 1 << 20;
+  double copy_ms;
+  double assign_ms;
+  PrintHeader("MAP<int, int> : COPY & ASSIGN 1M ELEMENTS");
+  CopyAndAssign<std::map<int, int> >(n_elem, &copy_ms, &assign_ms);
+  PrintRow("std::map, copy", copy_ms);
+  PrintRow("std::map, assign over 1M", assign_ms);
+  CopyAndAssign<ft::map<int, int> >(n_elem, &copy_ms, &assign_ms);
+  PrintRow("ft::map, copy", copy_ms);
+  PrintRow("ft::map, assign over 1M", assign_ms);
+  PrintFooter();
+}
+
+// SECTION : sorted bulk build
+void BenchSortedBuild(void) {
+  const size_t n_elem = 1 << 22;
+  ft::vector<ft::pair<int, int> > sorted;
+  ft::vector<std::pair<int, int> > std_sorted;
+  sorted.reserve(n_elem);
+  std_sorted.reserve(n_elem);
+  for (size_t i = 0; i < n_elem; ++i) {
+    sorted.push_back(ft::make_pair(static_cast<int>(i), 0));
+    std_sorted.push_back(std::make_pair(static_cast<int>(i), 0));
+  }
+  PrintHeader("MAP<int, int> : BUILD FROM 4M SORTED PAIRS");
+  {
+    Stopwatch sw;
+    std::map<int, int> m(std_sorted.begin(), std_sorted.end());
+    g_sink = m.size();
+    PrintRow("std::map, range constructor", sw.Elapsed());
+  }
+  {
+    Stopwatch sw;
+    ft::map<int, int> m(sorted.begin(), sorted.end());
+    g_sink = m.size();
+    PrintRow("ft::map, range constructor", sw.Elapsed());
+  }
+  {
+    Stopwatch sw;
+    ft::map<int, int> m(ft::sorted_unique, sorted.begin(), sorted.end());
+    g_sink = m.size();
+    PrintRow("ft::map, sorted_unique", sw.Elapsed());
+  }
+  PrintFooter();
+}
+
+// SECTION : hinted insert
+template <typename Map>
+double AppendInOrder(size_t n_elem, bool hinted) {
+  Stopwatch sw;
+  Map m;
+  for (size_t i = 0; i < n_elem; ++i) {
+    const typename Map::value_type val(static_cast<int>(i), 0);
+    if (hinted)
+      m.insert(m.end(), val);
+    else
+      m.insert(val);
+  }
+  g_sink = m.size();
+  return sw.Elapsed();
+}
+
+void BenchHintedInsert(void) {
+  const size_t n_elem = 1 << 22;
+  PrintHeader("MAP<int, int> : APPEND 4M ASCENDING KEYS");
+  PrintRow("std::map, insert(v)",
+           AppendInOrder<std::map<int, int> >(n_elem, false));
+  PrintRow("std::map, insert(end(), v)",
+           AppendInOrder<std::map<int, int> >(n_elem, true));
+  PrintRow("ft::map, insert(v)",
+           AppendInOrder<ft::map<int, int> >(n_elem, false));
+  PrintRow("ft::map, insert(end(), v)",
+           AppendInOrder<ft::map<int, int> >(n_elem, true));
+  PrintFooter();
+}
+
+// SECTION : clear
+template <typename Map>
+void FillAndClear(size_t n_elem, double* clear_ms, double* erase_ms) {
+  Map m;
+  for (size_t i = 0; i < n_elem; ++i)
+    m.insert(m.end(), typename Map::value_type(static_cast<int>(i),
+                                                typename Map::mapped_type()));
+  Map m2(m);
+  Stopwatch clear_sw;
+  m.clear();
+  *clear_ms = clear_sw.Elapsed();
+  Stopwatch erase_sw;
+  m2.erase(m2.begin(), m2.end());
+  *erase_ms = erase_sw.Elapsed();
+  g_sink = m.size() + m2.size();
+}
+
+void BenchClear(void) {
+  const size_t n_elem = 1 << 22;
+  double clear_ms;
+  double erase_ms;
+  PrintHeader("CLEAR & ERASE(BEGIN, END) OF 4M ELEMENTS");
+  FillAndClear<std::map<int, int> >(n_elem, &clear_ms, &erase_ms);
+  PrintRow("std::map<int, int>, clear", clear_ms);
+  PrintRow("std::map<int, int>, erase all", erase_ms);
+  FillAndClear<ft::map<int, int> >(n_elem, &clear_ms, &erase_ms);
+  PrintRow("ft::map<int, int>, clear", clear_ms);
+  PrintRow("ft::map<int, int>, erase all", erase_ms);
+  FillAndClear<ft::map<int, std::string> >(n_elem, &clear_ms, &erase_ms);
+  PrintRow("ft::map<int, string>, clear", clear_ms);
+  PrintRow("ft::map<int, string>, erase all", erase_ms);
+  PrintFooter();
+}
+
+// SECTION : order statistics
+typedef ft::map<int, int, std::less<int>,
+                std::allocator<ft::pair<const int, int> >,
+                ft::order_statistics>
+    RankedMap;
+
+// random inserts, then the keys inserted at an even step erased
+template <typename Map>
+double FillRandom(Map* m, size_t n_elem) {
+  Stopwatch sw;
+  srand(42);
+  for (size_t i = 0; i < n_elem; ++i) (*m)[rand()] = static_cast<int>(i);
+  for (typename Map::iterator it = m->begin(); it != m->end();) {
+    if (it->second % 2 == 0)
+      m->erase(it++);
+    else
+      ++it;
+  }
+  return sw.Elapsed();
+}
+
+void BenchOrderStatistics(void) {
+  const size_t n_elem = 1 << 20;
+  const int n_queries = 100;
+  const int key_step = RAND_MAX / n_queries;
+  ft::map<int, int> plain;
+  RankedMap ranked;
+  PrintHeader("MAP<int, int> : ORDER STATISTICS ON ~0.5M ELEMENTS");
+  PrintRow("plain, 1M inserts & erases", FillRandom(&plain, n_elem));
+  PrintRow("order_statistics, 1M inserts & erases",
+           FillRandom(&ranked, n_elem));
+  size_t sum = 0;
+  {
+    Stopwatch sw;
+    for (int i = 0; i < n_queries; ++i) {
+      ft::map<int, int>::iterator it = plain.begin();
+      std::advance(it, (plain.size() / n_queries) * i);
+      sum += it->first;
+    }
+    PrintRow("plain, 100 x advance(begin(), k)", sw.Elapsed());
+  }
+  {
+    Stopwatch sw;
+    for (int i = 0; i < n_queries; ++i)
+      sum += ranked.nth((ranked.size() / n_queries) * i)->first;
+    PrintRow("order_statistics, 100 x nth(k)", sw.Elapsed());
+  }
+  {
+    Stopwatch sw;
+    for (int i = 0; i < n_queries; ++i)
+      sum += std::distance(plain.begin(), plain.lower_bound(i * key_step));
+    PrintRow("plain, 100 x distance(begin(), lb)", sw.Elapsed());
+  }
+  {
+    Stopwatch sw;
+    for (int i = 0; i < n_queries; ++i) sum += ranked.rank(i * key_step);
+    PrintRow("order_statistics, 100 x rank(key)", sw.Elapsed());
+  }
+  g_sink = sum;
+  PrintFooter();
+}
+
+// SECTION : split & join
+// erases n_ranges ranges of range_size elements, starting at random keys
+template <typename Map>
+double EraseRanges(Map* m, size_t range_size, int n_ranges) {
+  Stopwatch sw;
+  srand(7);
+  for (int i = 0; i < n_ranges; ++i) {
+    typename Map::iterator first = m->lower_bound(rand() % (1 << 22));
+    typename Map::iterator last = first;
+    for (size_t j = 0; j < range_size && last != m->end(); ++j) ++last;
+    m->erase(first, last);
+  }
+  return sw.Elapsed();
+}
+
+template <typename Map>
+void FillAscending(Map* m, size_t n_elem) {
+  for (size_t i = 0; i < n_elem; ++i)
+    m->insert(m->end(), typename Map::value_type(static_cast<int>(i), 0));
+}
+
+void BenchSplitJoin(void) {
+  const size_t n_elem = 1 << 22;
+  PrintHeader("MAP<int, int> : RANGE ERASE, SPLIT & JOIN ON 4M ELEMENTS");
+  const size_t range_sizes[] = {16, 1024, 65536};
+  for (int i = 0; i < 3; ++i) {
+    std::ostringstream label;
+    label << "16 x erase " << range_sizes[i] << " elems";
+    std::map<int, int> std_map;
+    FillAscending(&std_map, n_elem);
+    PrintRow("std::map, " + label.str(),
+             EraseRanges(&std_map, range_sizes[i], 16));
+    ft::map<int, int> ft_map;
+    FillAscending(&ft_map, n_elem);
+    PrintRow("ft::map, " + label.str(),
+             EraseRanges(&ft_map, range_sizes[i], 16));
+  }
+  {
+    std::map<int, int> lower;
+    FillAscending(&lower, n_elem);
+    Stopwatch sw;
+    std::map<int, int> upper(lower.lower_bound(n_elem / 2), lower.end());
+    lower.erase(lower.lower_bound(n_elem / 2), lower.end());
+    lower.insert(upper.begin(), upper.end());
+    g_sink = lower.size();
+    PrintRow("std::map, copy, erase & insert half", sw.Elapsed());
+  }
+  {
+    ft::map<int, int> lower;
+    FillAscending(&lower, n_elem);
+    Stopwatch sw;
+    ft::map<int, int> upper;
+    lower.split(n_elem / 2, upper);
+    lower.join(upper);
+    g_sink = lower.size();
+    PrintRow("ft::map, split & join", sw.Elapsed());
+  }
+  PrintFooter();
+}
+
+// SECTION : key-only lookup
+// std::deque allocates as soon as it is default constructed
+typedef std::deque<int> Payload;
+
+template <typename Map>
+double FindAll(const Map& m, int n_elem, int n_rounds) {
+  Stopwatch sw;
+  size_t found = 0;
+  for (int round = 0; round < n_rounds; ++round)
+    for (int i = 0; i < n_elem; ++i) found += m.count(i * 2);
+  g_sink = found;
+  return sw.Elapsed();
+}
+
+template <typename Map>
+double FindByLiteral(const Map& m, const ft::vector<std::string>& keys,
+                     int n_rounds) {
+  Stopwatch sw;
+  size_t found = 0;
+  for (int round = 0; round < n_rounds; ++round)
+    for (size_t i = 0; i < keys.size(); ++i)
+      found += (m.find(keys[i].c_str()) != m.end());
+  g_sink = found;
+  return sw.Elapsed();
+}
+
+void BenchKeyLookup(void) {
+  const int n_elem = 1 << 16;
+  PrintHeader("MAP : 64K ELEMENTS, LOOKUPS BY KEY");
+  {
+    std::map<int, Payload> std_map;
+    ft::map<int, Payload> ft_map;
+    for (int i = 0; i < n_elem; ++i) {
+      std_map.insert(std_map.end(), std::make_pair(i, Payload()));
+      ft_map.insert(ft_map.end(), ft::make_pair(i, Payload()));
+    }
+    PrintRow("std::map<int, deque>, 16 x 64K count",
+             FindAll(std_map, n_elem, 16));
+    PrintRow("ft::map<int, deque>, 16 x 64K count",
+             FindAll(ft_map, n_elem, 16));
+  }
+  {
+    ft::vector<std::string> keys;
+    for (int i = 0; i < n_elem; ++i) {
+      std::ostringstream key;
+      key << "a key longer than the small string buffer " << i;
+      keys.push_back(key.str());
+    }
+    std::map<std::string, int> std_map;
+    ft::map<std::string, int> ft_map;
+    ft::map<std::string, int, ft::less<> > transparent_map;
+    for (int i = 0; i < n_elem; ++i) {
+      std_map[keys[i]] = i;
+      ft_map[keys[i]] = i;
+      transparent_map[keys[i]] = i;
+    }
+    PrintRow("std::map<string, int>, find(const char*)",
+             FindByLiteral(std_map, keys, 4));
+    PrintRow("ft::map<string, int>, find(const char*)",
+             FindByLiteral(ft_map, keys, 4));
+    PrintRow("ft::map<.., less<> >, find(const char*)",
+             FindByLiteral(transparent_map, keys, 4));
+  }
+  PrintFooter();
+}
+
+// SECTION : subscript
+template <typename Map>
+double SubscriptHits(Map* m, int n_elem, int n_rounds) {
+  Stopwatch sw;
+  size_t sum = 0;
+  for (int round = 0; round < n_rounds; ++round)
+    for (int i = 0; i < n_elem; ++i) sum += (*m)[i].size();
+  g_sink = sum;
+  return sw.Elapsed();
+}
+
+template <typename Map>
+double SubscriptMisses(Map* m, int n_elem) {
+  Stopwatch sw;
+  for (int i = 0; i < n_elem; ++i) (*m)[i].push_back('x');
+  g_sink = m->size();
+  return sw.Elapsed();
+}
+
+void BenchSubscript(void) {
+  const int n_elem = 1 << 16;
+  PrintHeader("MAP : 64K ELEMENTS, OPERATOR[]");
+  {
+    std::map<int, std::string> std_map;
+    ft::map<int, std::string> ft_map;
+    PrintRow("std::map<int, string>, 64K misses",
+             SubscriptMisses(&std_map, n_elem));
+    PrintRow("ft::map<int, string>, 64K misses",
+             SubscriptMisses(&ft_map, n_elem));
+    PrintRow("std::map<int, string>, 16 x 64K hits",
+             SubscriptHits(&std_map, n_elem, 16));
+    PrintRow("ft::map<int, string>, 16 x 64K hits",
+             SubscriptHits(&ft_map, n_elem, 16));
+  }
+  {
+    std::map<int, Payload> std_map;
+    ft::map<int, Payload> ft_map;
+    for (int i = 0; i < n_elem; ++i) {
+      std_map[i].push_back(i);
+      ft_map[i].push_back(i);
+    }
+    PrintRow("std::map<int, deque>, 16 x 64K hits",
+             SubscriptHits(&std_map, n_elem, 16));
+    PrintRow("ft::map<int, deque>, 16 x 64K hits",
+             SubscriptHits(&ft_map, n_elem, 16));
+  }
+  PrintFooter();
+}
+
+// SECTION : threaded scans
+typedef ft::map<int, int, std::less<int>,
+                std::allocator<ft::pair<const int, int> >, ft::threaded>
+    ThreadedMap;
+
+// one scan forward & one backward, over a map filled with ascending keys
+// (nodes laid out in key order) or in random order (nodes scattered)
+template <typename Map>
+void ScanBothWays(size_t n_elem, bool random, double* forward_ms,
+                  double* backward_ms) {
+  Map m;
+  srand(42);
+  for (size_t i = 0; i < n_elem; ++i) {
+    const int key = random ? rand() : static_cast<int>(i);
+    m.insert(m.end(), typename Map::value_type(key, static_cast<int>(i)));
+  }
+  size_t sum = 0;
+  Stopwatch forward;
+  for (typename Map::const_iterator it = m.begin(); it != m.end(); ++it)
+    sum += it->second;
+  *forward_ms = forward.Elapsed();
+  Stopwatch backward;
+  for (typename Map::const_reverse_iterator it = m.rbegin(); it != m.rend();
+       ++it)
+    sum += it->second;
+  *backward_ms = backward.Elapsed();
+  g_sink = sum;
+}
+
+template <typename Map>
+void PrintScans(const std::string& name, size_t n_elem) {
+  double forward_ms = 0;
+  double backward_ms = 0;
+  ScanBothWays<Map>(n_elem, false, &forward_ms, &backward_ms);
+  PrintRow(name + ", ascending, forward", forward_ms);
+  PrintRow(name + ", ascending, backward", backward_ms);
+  ScanBothWays<Map>(n_elem, true, &forward_ms, &backward_ms);
+  PrintRow(name + ", random, forward", forward_ms);
+  PrintRow(name + ", random, backward", backward_ms);
+}
+
+void BenchThreaded(void) {
+  const size_t n_elem = 10000000;
+  PrintHeader("MAP : 10M KEYS, FULL SCANS");
+  PrintScans<std::map<int, int> >("std::map", n_elem);
+  PrintScans<ft::map<int, int> >("ft::map", n_elem);
+  PrintScans<ThreadedMap>("threaded", n_elem);
+  PrintFooter();
+}
+
+// SECTION : B+ tree vs red-black tree
+// maps hold value_type(key, key), sets the key itself
+template <typename Value>
+struct KeyEntry {
+  static Value Make(int key) { return Value(key, key); }
+
+  static int Key(const Value& value) { return value.first; }
+};
+
+template <>
+struct KeyEntry<int> {
+  static int Make(int key) { return key; }
+
+  static int Key(int value) { return value; }
+};
+
+// n random keys inserted, looked up (half of them misses) & scanned
+// n_rounds times, then erased
+template <typename Tree>
+void PrintTreeOps(const std::string& name, size_t n_elem, int n_rounds) {
+  typedef KeyEntry<typename Tree::value_type> Entry;
+  ft::vector<int> keys(n_elem);
+  srand(42);
+  for (size_t i = 0; i < n_elem; ++i) keys[i] = rand() & ~1;
+  Tree tree;
+  Stopwatch insert;
+  for (size_t i = 0; i < n_elem; ++i) tree.insert(Entry::Make(keys[i]));
+  PrintRow(name + ", insert", insert.Elapsed());
+  size_t sum = 0;
+  Stopwatch find;
+  for (int round = 0; round < n_rounds; ++round)
+    for (size_t i = 0; i < n_elem; ++i) sum += tree.count(keys[i] + round % 2);
+  PrintRow(name + ", find", find.Elapsed());
+  Stopwatch scan;
+  for (int round = 0; round < n_rounds; ++round)
+    for (typename Tree::const_iterator it = tree.begin(); it != tree.end();
+         ++it)
+      sum += Entry::Key(*it);
+  PrintRow(name + ", scan", scan.Elapsed());
+  Stopwatch erase;
+  for (size_t i = 0; i < n_elem; ++i) sum += tree.erase(keys[i]);
+  PrintRow(name + ", erase", erase.Elapsed());
+  g_sink = sum;
+}
+
+void BenchBTree(void) {
+  const char* sizes[] = {"1K", "64K", "1M"};
+  const size_t n_elems[] = {1 << 10, 1 << 16, 1 << 20};
+  const int n_rounds[] = {1024, 16, 1};
+  for (int i = 0; i < 3; ++i) {
+    const std::string size = sizes[i];
+    std::ostringstream title;
+    title << "MAP & SET : " << size << " RANDOM KEYS, FINDS & SCANS x "
+          << n_rounds[i];
+    PrintHeader(title.str());
+    PrintTreeOps<std::map<int, int> >("std::map, " + size, n_elems[i],
+                                      n_rounds[i]);
+    PrintTreeOps<ft::map<int, int> >("ft::map, " + size, n_elems[i],
+                                     n_rounds[i]);
+    PrintTreeOps<ft::btree_map<int, int> >("ft::btree_map, " + size,
+                                           n_elems[i], n_rounds[i]);
+    PrintTreeOps<std::set<int> >("std::set, " + size, n_elems[i], n_rounds[i]);
+    PrintTreeOps<ft::set<int> >("ft::set, " + size, n_elems[i], n_rounds[i]);
+    PrintTreeOps<ft::btree_set<int> >("ft::btree_set, " + size, n_elems[i],
+                                      n_rounds[i]);
+    PrintFooter();
+  }
+}
+
+// SECTION : flat map vs red-black tree
+// n random keys built in one range insert, then looked up n_rounds times
+template <typename Map>
+void PrintBulkOps(const std::string& name, size_t n_elem, int n_rounds) {
+  ft::vector<ft::pair<int, int> > pairs(n_elem);
+  srand(42);
+  for (size_t i = 0; i < n_elem; ++i) {
+    const int key = rand() & ~1;
+    pairs[i] = ft::make_pair(key, key);
+  }
+  Map m;
+  Stopwatch build;
+  m.insert(pairs.begin(), pairs.end());
+  PrintRow(name + ", range insert", build.Elapsed());
+  size_t sum = 0;
+  Stopwatch find;
+  for (int round = 0; round < n_rounds; ++round)
+    for (size_t i = 0; i < n_elem; ++i)
+      sum += m.count(pairs[i].first + round % 2);
+  PrintRow(name + ", find", find.Elapsed());
+  g_sink = sum;
+}
+
+void BenchFlat(void) {
+  const char* sizes[] = {"64", "1K", "16K"};
+  const size_t n_elems[] = {1 << 6, 1 << 10, 1 << 14};
+  const int n_rounds[] = {16384, 1024, 64};
+  for (int i = 0; i < 3; ++i) {
+    const std::string size = sizes[i];
+    std::ostringstream title;
+    title << "FLAT MAP & SET : " << size << " RANDOM KEYS, FINDS & SCANS x "
+          << n_rounds[i];
+    PrintHeader(title.str());
+    PrintTreeOps<ft::map<int, int> >("ft::map, " + size, n_elems[i],
+                                     n_rounds[i]);
+    PrintTreeOps<ft::flat_map<int, int> >("ft::flat_map, " + size,
+                                          n_elems[i], n_rounds[i]);
+    PrintTreeOps<ft::set<int> >("ft::set, " + size, n_elems[i], n_rounds[i]);
+    PrintTreeOps<ft::flat_set<int> >("ft::flat_set, " + size, n_elems[i],
+                                     n_rounds[i]);
+    PrintFooter();
+  }
+  PrintHeader("FLAT MAP : 1M RANDOM KEYS IN ONE RANGE, FINDS x 4");
+  PrintBulkOps<ft::map<int, int> >("ft::map, 1M", 1 << 20, 4);
+  PrintBulkOps<ft::btree_map<int, int> >("ft::btree_map, 1M", 1 << 20, 4);
+  PrintBulkOps<ft::flat_map<int, int> >("ft::flat_map, 1M", 1 << 20, 4);
+  PrintFooter();
+}
+
+// SECTION : sharded concurrent map vs one locked map
+// ft::map behind one mutex, with the interface of concurrent_map
+class LockedMap {
+ public:
+  typedef ft::map<int, int>::value_type value_type;
+
+  LockedMap(void) { pthread_mutex_init(&lock_, NULL); }
+
+  ~LockedMap(void) { pthread_mutex_destroy(&lock_); }
+
+  bool find(int key, int& out) {
+    pthread_mutex_lock(&lock_);
+    ft::map<int, int>::const_iterator it = elems_.find(key);
+    const bool found = (it != elems_.end());
+    if (found) out = it->second;
+    pthread_mutex_unlock(&lock_);
+    return found;
+  }
+
+  bool insert(const value_type& val) {
+    pthread_mutex_lock(&lock_);
+    const bool inserted = elems_.insert(val).second;
+    pthread_mutex_unlock(&lock_);
+    return inserted;
+  }
+
+  size_t erase(int key) {
+    pthread_mutex_lock(&lock_);
+    const size_t erased = elems_.erase(key);
+    pthread_mutex_unlock(&lock_);
+    return erased;
+  }
+
+ private:
+  pthread_mutex_t lock_;
+  ft::map<int, int> elems_;
+
+  LockedMap(const LockedMap&);
+  LockedMap& operator=(const LockedMap&);
+};
+
+template <typename Table>
+struct TableJob {
+  Table* table;
+  unsigned seed;
+  size_t n_ops;
+  size_t hits;
+};
+
+// 90% finds, 5% inserts & 5% erases of random keys in [0, 1 << 16)
+template <typename Table>
+void* RunTableJob(void* arg) {
+  TableJob<Table>* job = static_cast<TableJob<Table>*>(arg);
+  unsigned seed = job->seed;
+  int out = 0;
+  for (size_t i = 0; i < job->n_ops; ++i) {
+    seed = seed * 1103515245 + 12345;
+    const int key = (seed >> 8) & 0xffff;
+    const unsigned op = (seed >> 24) % 20;
+    if (op == 0)
+      job->table->insert(ft::make_pair(key, key));
+    else if (op == 1)
+      job->table->erase(key);
+    else
+      job->hits += job->table->find(key, out);
+  }
+  return NULL;
+}
+
+// n_ops operations split over n_threads threads on a table of 32K keys
+template <typename Table>
+double RunTableJobs(size_t n_threads, size_t n_ops) {
+  Table table;
+  for (int key = 0; key < (1 << 16); key += 2)
+    table.insert(ft::make_pair(key, key));
+  ft::vector<pthread_t> tids(n_threads);
+  ft::vector<TableJob<Table> > jobs(n_threads);
+  Stopwatch sw;
+  for (size_t i = 0; i < n_threads; ++i) {
+    TableJob<Table> job = {&table, static_cast<unsigned>(i + 1),
+                           n_ops / n_threads, 0};
+    jobs[i] = job;
+    pthread_create(&tids[i], NULL, RunTableJob<Table>, &jobs[i]);
+  }
+  size_t hits = 0;
+  for (size_t i = 0; i < n_threads; ++i) {
+    pthread_join(tids[i], NULL);
+    hits += jobs[i].hits;
+  }
+  const double ms = sw.Elapsed();
+  g_sink = hits;
+  return ms;
+}
+
+void BenchConcurrentMap(void) {
+  const size_t n_ops = 1 << 21;
+  PrintHeader("CONCURRENT MAP : 2M OPS (90% FIND), 32K KEYS");
+  for (size_t n_threads = 1; n_threads <= 64; n_threads *= 2) {
+    std::ostringstream label;
+    label << n_threads << " thread(s)";
+    PrintRow("ft::map + mutex, " + label.str(),
+             RunTableJobs<LockedMap>(n_threads, n_ops));
+    PrintRow("ft::concurrent_map, " + label.str(),
+             RunTableJobs<ft::concurrent_map<int, int> >(n_threads, n_ops));
+  }
+  PrintFooter();
+}
+
+int main(void) {
+  BenchSmallVector();
+  BenchParallel();
+  BenchDequeStack();
+  BenchMappedVector();
+  BenchNodePool();
+  BenchMapCopy();
+  BenchSortedBuild();
+  BenchHintedInsert();
+  BenchClear();
+  BenchOrderStatistics();
+  BenchSplitJoin();
+  BenchKeyLookup();
+  BenchSubscript();
+  BenchThreaded();
+  BenchBTree();
+  BenchFlat();
+  BenchConcurrentMap();
+  return EXIT_SUCCESS;
+}
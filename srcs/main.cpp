@@ -9,6 +9,7 @@
 #include <vector>
 namespace ft = std;
 #else
+#include <deque.hpp>
 #include <map.hpp>
 #include <stack.hpp>
 #include <vector.hpp>
@@ -47,7 +48,7 @@ void test(void) {
   ft::vector<int> vector_int;
   ft::stack<int> stack_int;
   ft::vector<Buffer> vector_buffer;
-  ft::stack<Buffer, std::deque<Buffer> > stack_deq_buffer;
+  ft::stack<Buffer, ft::deque<Buffer> > stack_deq_buffer;
   ft::map<int, int> map_int;
 
   for (int i = 0; i < COUNT; i++) {
@@ -1,19 +1,33 @@
+#include <pthread.h>
+
+#include <cstddef>
 #include <iostream>
+#include <limits>
 #include <string>
 
 #ifdef STD
+#include <deque>
 #include <map>
 #include <set>
 #include <stack>
 #include <vector>
 namespace ft = std;
 #else
+#include <btree_map.hpp>
+#include <btree_set.hpp>
+#include <concurrent_map.hpp>
+#include <deque.hpp>
+#include <flat_map.hpp>
+#include <flat_set.hpp>
 #include <map.hpp>
+#include <mapped_vector.hpp>
 #include <set.hpp>
+#include <small_vector.hpp>
 #include <stack.hpp>
 #include <vector.hpp>
 #endif
 
+#include <cstdio>
 #include <cstdlib>
 
 template <typename T>
@@ -125,6 +139,141 @@ void TestVector(void) {
   PrintVector(v1);
 }
 
+// SECTION : vector<bool> tests
+void PrintBits(const ft::vector<bool>& v) {
+  std::cout << "SIZE : " << v.size() << ", BITS : ";
+  for (ft::vector<bool>::const_iterator it = v.begin(); it != v.end(); ++it)
+    std::cout << *it;
+  std::cout << "\n";
+}
+
+void TestVectorBool(void) {
+  ft::vector<bool> v;
+  ft::vector<bool> v1(70, true);
+
+  // push_back, pop_back, element access & proxy reference
+  std::cout << "VECTOR<BOOL> - PUSH_BACK, POP_BACK & ELEMENT ACCESS\n\n";
+  for (int i = 0; i < 130; ++i) v.push_back(i % 3 == 0);
+  v.pop_back();
+  PrintBits(v);
+  v[1] = true;
+  v[0].flip();
+  v.at(128) = v[1];
+  std::cout << "FRONT : " << v.front() << ", BACK : " << v.back()
+            << ", [1] : " << v[1] << ", ![2] : " << !v[2] << "\n";
+  try {
+    v.at(129);
+  } catch (const std::out_of_range& e) {
+    std::cout << "EXCEPTION : out of range\n";
+  }
+  ft::vector<bool>::swap(v[0], v[1]);
+  PrintBits(v);
+  std::cout << "\n========================================\n\n";
+
+  // insert, erase, resize & flip
+  std::cout << "VECTOR<BOOL> - INSERT, ERASE, RESIZE & FLIP\n\n";
+  v.insert(v.begin() + 5, true);
+  v.insert(v.begin() + 60, 10, true);
+  v.insert(v.end() - 3, v1.begin(), v1.begin() + 4);
+  PrintBits(v);
+  v.erase(v.begin());
+  v.erase(v.begin() + 10, v.begin() + 80);
+  PrintBits(v);
+  v.resize(100, true);
+  v.resize(90);
+  v.flip();
+  PrintBits(v);
+  std::cout << "REVERSED : ";
+  for (ft::vector<bool>::reverse_iterator it = v.rbegin(); it != v.rend();
+       ++it)
+    std::cout << *it;
+  std::cout << "\n\n========================================\n\n";
+
+  // assign, copy, swap & relational operators
+  std::cout << "VECTOR<BOOL> - ASSIGN, COPY, SWAP & RELATIONAL OPERATORS\n\n";
+  ft::vector<bool> v2(v);
+  std::cout << "COPY == ORIGINAL? : " << (v2 == v ? "YES" : "NO") << "\n";
+  v2.assign(65, false);
+  std::cout << "V2 < V? : " << (v2 < v ? "YES" : "NO")
+            << ", V2 != V? : " << (v2 != v ? "YES" : "NO") << "\n";
+  v2.assign(v1.begin(), v1.end());
+  ft::swap(v, v2);
+  PrintBits(v);
+  PrintBits(v2);
+  v2.clear();
+  std::cout << "SIZE AFTER CLEAR : " << v2.size()
+            << ", EMPTY? : " << (v2.empty() ? "YES" : "NO") << "\n";
+  std::cout << "\n========================================\n\n";
+}
+
+// SECTION : deque tests
+template <typename T>
+void PrintDeque(const ft::deque<T>& d) {
+  std::cout << "\nSIZE : " << d.size() << "\n";
+  std::cout << "Contents :";
+  for (typename ft::deque<T>::const_iterator it = d.begin(); it != d.end();
+       ++it)
+    std::cout << " " << *it;
+  std::cout << "\n\n========================================\n\n";
+}
+
+void TestDeque(void) {
+  ft::deque<int> d;
+  ft::deque<int> d1(5, 42);
+
+  // push & pop at both ends, across several blocks
+  std::cout << "DEQUE - PUSH & POP AT BOTH ENDS";
+  for (int i = 0; i < 3000; ++i) {
+    d.push_back(i);
+    d.push_front(-i);
+  }
+  std::cout << "\nFRONT : " << d.front() << ", BACK : " << d.back()
+            << ", SIZE : " << d.size() << ", [3000] : " << d[3000]
+            << ", AT(4500) : " << d.at(4500) << "\n";
+  const int& stable = d[1234];
+  for (int i = 0; i < 3000; ++i) d.push_front(i);
+  std::cout << "REFERENCE AFTER PUSH_FRONT : " << stable << "\n";
+  for (int i = 0; i < 8990; ++i) {
+    if (i % 2)
+      d.pop_back();
+    else
+      d.pop_front();
+  }
+  PrintDeque(d);
+
+  // insert, erase & iterators
+  std::cout << "DEQUE - INSERT, ERASE & ITERATORS";
+  d.insert(d.begin() + 2, 100);
+  d.insert(d.end() - 1, 3, 200);
+  d.insert(d.begin() + 1, d1.begin(), d1.end());
+  PrintDeque(d);
+  d.erase(d.begin() + 1);
+  d.erase(d.begin() + 2, d.begin() + 6);
+  PrintDeque(d);
+  std::cout << "DISTANCE : " << (d.end() - d.begin()) << ", REVERSED :";
+  for (ft::deque<int>::reverse_iterator it = d.rbegin(); it != d.rend(); ++it)
+    std::cout << " " << *it;
+  std::cout << "\n\n========================================\n\n";
+
+  // assign, resize, copy, swap & relational operators
+  std::cout << "DEQUE - ASSIGN, RESIZE, COPY, SWAP & RELATIONAL OPERATORS";
+  ft::deque<std::string> ds(3, "deque");
+  ds.resize(5, "resized");
+  ds.push_front("front");
+  ft::deque<std::string> ds1(ds);
+  std::cout << "\nCOPY == ORIGINAL? : " << (ds1 == ds ? "YES" : "NO") << "\n";
+  ds1.assign(2, "assigned");
+  std::cout << "DS < DS1? : " << (ds < ds1 ? "YES" : "NO") << "\n";
+  ft::swap(ds, ds1);
+  PrintDeque(ds);
+  PrintDeque(ds1);
+  ds1 = ds;
+  ds.clear();
+  std::cout << "SIZE AFTER CLEAR : " << ds.size()
+            << ", EMPTY? : " << (ds.empty() ? "YES" : "NO") << "\n";
+  PrintDeque(ds1);
+}
+
 // SECTION : stack tests
 void TestStack(void) {
   ft::vector<int> v(20);
@@ -159,6 +308,14 @@ void TestStack(void) {
 }
 
 // SECTION : map tests
+struct NoDefault {
+  int value;
+
+  explicit NoDefault(int v) : value(v) {}
+
+  bool operator<(const NoDefault& rhs) const { return value < rhs.value; }
+};
+
 void TestMap(void) {
   ft::vector<ft::pair<int, char> > v;
   v.reserve(10);
@@ -233,6 +390,20 @@ void TestMap(void) {
     m3.clear();
     std::cout << "SIZE AFTER CLEAR : " << m3.size() << "\n";
   }
+
+  // lookups only need the key
+  std::cout << "MAP - MAPPED TYPE WITHOUT DEFAULT CONSTRUCTOR\n\n";
+  {
+    ft::map<int, NoDefault> m5;
+    for (int i = 0; i < 10; ++i) m5.insert(ft::make_pair(i * 2, NoDefault(i)));
+    std::cout << "FIND(4) : " << m5.find(4)->second.value
+              << ", COUNT(5) : " << m5.count(5)
+              << ", LOWER_BOUND(5) : " << m5.lower_bound(5)->first
+              << ", UPPER_BOUND(6) : " << m5.upper_bound(6)->first << "\n";
+    std::cout << "ERASE(8) : " << m5.erase(8) << ", ERASE(9) : " << m5.erase(9)
+              << ", SIZE : " << m5.size() << "\n";
+  }
+  std::cout << "\n========================================\n\n";
 }
 
 // SECTION : set tests
@@ -306,13 +477,738 @@ void TestSet(void) {
     s3.clear();
     std::cout << "SIZE AFTER CLEAR : " << s3.size() << "\n";
   }
+
+  // keys without a default constructor, empty sets
+  std::cout << "SET - KEY WITHOUT DEFAULT CONSTRUCTOR\n\n";
+  {
+    ft::set<NoDefault> s5;
+    ft::set<NoDefault> s6(s5);
+    std::cout << "EMPTY BEGIN == END? : "
+              << (s5.begin() == s5.end() ? "YES" : "NO") << "\n";
+    for (int i = 5; i > 0; --i) s5.insert(NoDefault(i * 3));
+    s5.erase(NoDefault(9));
+    s6 = s5;
+    for (ft::set<NoDefault>::reverse_iterator it = s6.rbegin();
+         it != s6.rend(); ++it)
+      std::cout << it->value << "\n";
+    s6.erase(s6.begin(), s6.end());
+    std::cout << "SIZE : " << s6.size() << ", EMPTY BEGIN == END? : "
+              << (s6.begin() == s6.end() ? "YES" : "NO") << "\n";
+  }
+  std::cout << "\n========================================\n\n";
+}
+
+// SECTION : ft only extensions (no std counterpart, not run with STD)
+#ifndef STD
+// counts the calls to allocate, to check what does not allocate
+static size_t g_allocations = 0;
+
+template <typename T>
+class CountingAllocator : public std::allocator<T> {
+ public:
+  typedef typename std::allocator<T>::pointer pointer;
+  typedef typename std::allocator<T>::size_type size_type;
+
+  template <typename U>
+  struct rebind {
+    typedef CountingAllocator<U> other;
+  };
+
+  CountingAllocator(void) {}
+
+  template <typename U>
+  CountingAllocator(const CountingAllocator<U>&) {}
+
+  pointer allocate(size_type n, const void* hint = 0) {
+    ++g_allocations;
+    return std::allocator<T>::allocate(n, hint);
+  }
+};
+
+void TestEmptyDequeAllocation(void) {
+  std::cout << "DEQUE & STACK - EMPTY CONSTRUCTION\n\n";
+  typedef ft::deque<int, CountingAllocator<int> > CountingDeque;
+  g_allocations = 0;
+  {
+    CountingDeque d;
+    ft::stack<int, CountingDeque> st;
+    CountingDeque copy(d);
+    copy.clear();
+    copy.swap(d);
+    std::cout << "ALLOCATIONS WHEN EMPTY : " << g_allocations
+              << ", SIZE : " << d.size() << ", BEGIN == END : "
+              << (d.begin() == d.end()) << "\n";
+    st.push(42);
+    d.push_front(7);
+    std::cout << "ALLOCATIONS AFTER PUSH : " << g_allocations
+              << ", TOP : " << st.top() << ", FRONT : " << d.front() << "\n";
+  }
+  std::cout << "\n========================================\n\n";
+}
+
+void TestSmallVector(void) {
+  ft::small_vector<std::string, 4> sv;
+  ft::small_vector<std::string, 4> sv1(3, "inline");
+
+  // inline storage & spill to the heap
+  std::cout << "SMALL_VECTOR - INLINE & SPILL\n\n";
+  std::cout << "CAPACITY : " << sv.capacity()
+            << ", INLINE? : " << (sv.is_inline() ? "YES" : "NO") << "\n";
+  for (int i = 0; i < 6; ++i) {
+    sv.push_back("pushed");
+    std::cout << "SIZE : " << sv.size() << ", CAPACITY : " << sv.capacity()
+              << ", INLINE? : " << (sv.is_inline() ? "YES" : "NO") << "\n";
+  }
+  sv.insert(sv.begin() + 1, "inserted");
+  sv.erase(sv.end() - 2, sv.end());
+  for (ft::small_vector<std::string, 4>::iterator it = sv.begin();
+       it != sv.end(); ++it)
+    std::cout << "  " << *it << "\n";
+  std::cout << "\n========================================\n\n";
+
+  // copy, swap & relational operators
+  std::cout << "SMALL_VECTOR - COPY, SWAP & RELATIONAL OPERATORS\n\n";
+  ft::small_vector<std::string, 4> sv2(sv1);
+  std::cout << "COPY == ORIGINAL? : " << (sv2 == sv1 ? "YES" : "NO") << "\n";
+  ft::swap(sv, sv1);
+  std::cout << "SIZE : " << sv.size()
+            << ", INLINE? : " << (sv.is_inline() ? "YES" : "NO") << "\n";
+  std::cout << "SIZE : " << sv1.size()
+            << ", INLINE? : " << (sv1.is_inline() ? "YES" : "NO") << "\n";
+  std::cout << "SV < SV1? : " << (sv < sv1 ? "YES" : "NO") << "\n";
+  std::cout << "\n========================================\n\n";
+
+  // as the container of a stack
+  std::cout << "SMALL_VECTOR - STACK CONTAINER\n\n";
+  ft::stack<int, ft::small_vector<int, 8> > st;
+  for (int i = 0; i < 10; ++i) st.push(i);
+  std::cout << "TOP : " << st.top() << ", SIZE : " << st.size() << "\n";
+  std::cout << "\n========================================\n\n";
+}
+
+bool IsOdd(int n) { return n % 2 != 0; }
+
+bool IsEmptyString(const std::string& str) { return str.empty(); }
+
+void TestEraseIf(void) {
+  std::cout << "VECTOR - ERASE_IF\n\n";
+  ft::vector<int> v;
+  for (int i = 0; i < 10; ++i) v.push_back(i);
+  std::cout << "REMOVED : " << ft::erase_if(v, IsOdd) << "\n";
+  for (ft::vector<int>::iterator it = v.begin(); it != v.end(); ++it)
+    std::cout << "  " << *it << "\n";
+  ft::vector<std::string> vs;
+  vs.push_back("");
+  vs.push_back("kept");
+  vs.push_back("");
+  vs.push_back("");
+  vs.push_back("also kept");
+  std::cout << "REMOVED : " << ft::erase_if(vs, IsEmptyString) << "\n";
+  for (ft::vector<std::string>::iterator it = vs.begin(); it != vs.end(); ++it)
+    std::cout << "  " << *it << "\n";
+  ft::small_vector<int, 8> sv(5, 3);
+  std::cout << "REMOVED : " << ft::erase_if(sv, IsOdd)
+            << ", SIZE : " << sv.size() << "\n";
+  std::cout << "\n========================================\n\n";
+}
+
+void TestParallel(void) {
+  std::cout << "VECTOR - PARALLEL EXECUTION\n\n";
+  ft::set_parallel_execution(4, 16);
+  ft::vector<int> v(1000, 42);
+  ft::vector<int> v1(v);
+  v1.resize(2000, 7);
+  std::cout << "SIZE : " << v1.size() << ", FRONT : " << v1.front()
+            << ", AT(999) : " << v1.at(999) << ", BACK : " << v1.back()
+            << "\n";
+  std::cout << "COPY == ORIGINAL? : "
+            << (ft::vector<int>(v1.begin(), v1.begin() + 1000) == v ? "YES"
+                                                                     : "NO")
+            << "\n";
+  ft::vector<std::string> vs(100, "parallel");
+  vs.resize(10);
+  vs.clear();
+  std::cout << "SIZE AFTER CLEAR : " << vs.size() << "\n";
+  ft::set_parallel_execution(1);
+  std::cout << "\n========================================\n\n";
+}
+
+void TestBitOperations(void) {
+  std::cout << "VECTOR<BOOL> - COUNT, FIND & BITWISE OPERATIONS\n\n";
+  ft::vector<bool> a(200);
+  ft::vector<bool> b(200);
+  for (size_t i = 0; i < a.size(); i += 3) a[i] = true;
+  for (size_t i = 0; i < b.size(); i += 5) b[i] = true;
+  std::cout << "COUNT A : " << a.count() << ", COUNT B : " << b.count()
+            << "\n";
+  ft::vector<bool> both(a);
+  both &= b;
+  std::cout << "A & B :";
+  for (size_t i = both.find_first(); i != ft::vector<bool>::npos;
+       i = both.find_next(i))
+    std::cout << " " << i;
+  ft::vector<bool> either(a);
+  either |= b;
+  ft::vector<bool> one(a);
+  one ^= b;
+  std::cout << "\nCOUNT A | B : " << either.count()
+            << ", COUNT A ^ B : " << one.count() << "\n";
+  std::cout << "FIND IN EMPTY : "
+            << (ft::vector<bool>(64).find_first() == ft::vector<bool>::npos
+                    ? "NPOS"
+                    : "FOUND")
+            << "\n";
+  try {
+    a &= ft::vector<bool>(3);
+  } catch (const std::invalid_argument& e) {
+    std::cout << "EXCEPTION : size mismatch\n";
+  }
+  std::cout << "\n========================================\n\n";
+}
+
+void TestMappedVector(void) {
+  const char* path = "mapped_vector_test.ftmv";
+  std::remove(path);
+
+  // write, then reload from the file
+  std::cout << "MAPPED_VECTOR - WRITE & RELOAD\n\n";
+  {
+    ft::mapped_vector<ft::pair<int, int> > mv(path);
+    for (int i = 0; i < 5000; ++i) mv.push_back(ft::make_pair(i, i * i));
+    mv.erase(mv.begin(), mv.begin() + 10);
+    mv.pop_back();
+    std::cout << "SIZE : " << mv.size()
+              << ", CAPACITY >= SIZE? : "
+              << (mv.capacity() >= mv.size() ? "YES" : "NO") << "\n";
+  }
+  ft::mapped_vector<ft::pair<int, int> > mv(path);
+  std::cout << "SIZE AFTER REOPEN : " << mv.size()
+            << ", FRONT : " << mv.front().first << ", BACK : " << mv.back().first
+            << ", AT(100) : " << mv.at(100).second << "\n";
+  long sum = 0;
+  for (ft::mapped_vector<ft::pair<int, int> >::const_reverse_iterator it =
+           mv.rbegin();
+       it != mv.rend(); ++it)
+    sum += it->first;
+  std::cout << "SUM : " << sum << "\n";
+  mv.resize(3);
+  mv.close();
+  mv.open(path);
+  std::cout << "SIZE AFTER RESIZE : " << mv.size() << "\n";
+
+  // a file of another element type is refused
+  try {
+    ft::mapped_vector<char> wrong(path);
+    std::cout << "OPENED?!\n";
+  } catch (const std::exception& e) {
+    std::cout << "EXCEPTION : element size mismatch\n";
+  }
+  mv.close();
+
+  // a size field past the end of the file is refused, even when the byte
+  // count it implies wraps around
+  const size_t bogus_size =
+      std::numeric_limits<size_t>::max() / sizeof(int) + 1;
+  std::FILE* file = std::fopen(path, "r+b");
+  std::fseek(file, offsetof(ft::MappedVectorHeader, size), SEEK_SET);
+  std::fwrite(&bogus_size, sizeof(bogus_size), 1, file);
+  std::fclose(file);
+  try {
+    ft::mapped_vector<ft::pair<int, int> > corrupt(path);
+    std::cout << "OPENED?!\n";
+  } catch (const std::exception& e) {
+    std::cout << "EXCEPTION : size field past the end of the file\n";
+  }
+  std::remove(path);
+
+  // nothing to resize without a file
+  ft::mapped_vector<int> closed;
+  closed.resize(0);
+  closed.assign(0, 42);
+  std::cout << "CLOSED SIZE : " << closed.size();
+  try {
+    closed.resize(1);
+    std::cout << ", RESIZED?!\n";
+  } catch (const std::logic_error& e) {
+    std::cout << ", EXCEPTION : no file is open\n";
+  }
+  std::cout << "\n========================================\n\n";
+}
+
+void TestNodePool(void) {
+  std::cout << "MAP & SET - RESERVE & NODE REUSE\n\n";
+  ft::map<int, std::string> m;
+  m.reserve(100);
+  for (int i = 0; i < 100; ++i) m[i] = std::string(i % 7 + 1, 'a' + i % 26);
+  for (int i = 0; i < 100; i += 2) m.erase(i);
+  for (int i = 100; i < 150; ++i) m[i] = "reused";
+  std::cout << "SIZE : " << m.size() << ", FRONT : " << m.begin()->first
+            << ", BACK : " << m.rbegin()->second << "\n";
+  ft::map<int, std::string> copy(m);
+  m.clear();
+  m.reserve(10);
+  m[42] = "after clear";
+  m.swap(copy);
+  std::cout << "SWAPPED SIZES : " << m.size() << ", " << copy.size()
+            << ", COPY[42] : " << copy[42] << "\n";
+  ft::set<int> s;
+  s.reserve(1000);
+  for (int i = 0; i < 1000; ++i) s.insert((i * 7919) % 1000);
+  s.erase(s.begin(), s.find(500));
+  std::cout << "SET SIZE : " << s.size() << ", FRONT : " << *s.begin() << "\n";
+  std::cout << "MAP<int, int> NODE IS 3 WORDS + PAIR? : "
+            << (sizeof(ft::RbTreeNode<ft::pair<const int, int> >) ==
+                        3 * sizeof(void*) + sizeof(ft::pair<const int, int>)
+                    ? "YES"
+                    : "NO")
+            << "\n";
+  std::cout << "\n========================================\n\n";
+}
+
+void TestSortedBuild(void) {
+  std::cout << "MAP & SET - SORTED BULK BUILD\n\n";
+  ft::vector<ft::pair<int, std::string> > sorted;
+  for (int i = 0; i < 1000; ++i)
+    sorted.push_back(ft::make_pair(i * 2, std::string(1, 'a' + i % 26)));
+  ft::map<int, std::string> detected(sorted.begin(), sorted.end());
+  ft::map<int, std::string> tagged(ft::sorted_unique, sorted.begin(),
+                                   sorted.end());
+  std::cout << "SIZES : " << detected.size() << ", " << tagged.size()
+            << ", EQUAL? : " << (detected == tagged ? "YES" : "NO") << "\n";
+  std::cout << "FRONT : " << tagged.begin()->first
+            << ", BACK : " << tagged.rbegin()->first
+            << ", FIND(1000) : " << tagged.find(1000)->second << "\n";
+  tagged.insert(ft::sorted_unique, sorted.begin(), sorted.begin() + 10);
+  tagged[1] = "odd";
+  std::cout << "SIZE : " << tagged.size() << ", [1] : " << tagged[1] << "\n";
+  ft::vector<int> unsorted;
+  for (int i = 0; i < 10; ++i) unsorted.push_back((i * 7) % 10);
+  ft::set<int> s(unsorted.begin(), unsorted.end());
+  for (ft::set<int>::iterator it = s.begin(); it != s.end(); ++it)
+    std::cout << *it << " ";
+  std::cout << "\n\n========================================\n\n";
+}
+
+void TestOrderStatistics(void) {
+  std::cout << "MAP & SET - ORDER STATISTICS\n\n";
+  typedef ft::map<int, char, std::less<int>,
+                  std::allocator<ft::pair<const int, char> >,
+                  ft::order_statistics>
+      RankedMap;
+  RankedMap m;
+  for (int i = 0; i < 100; ++i) m[(i * 37) % 100 * 10] = 'a' + i % 26;
+  for (int i = 0; i < 100; i += 2) m.erase(i * 10);
+  std::cout << "SIZE : " << m.size() << ", NTH(0) : " << m.nth(0)->first
+            << ", NTH(10) : " << m.nth(10)->first
+            << ", NTH(SIZE) == END? : "
+            << (m.nth(m.size()) == m.end() ? "YES" : "NO") << "\n";
+  std::cout << "RANK(10) : " << m.rank(10) << ", RANK(505) : " << m.rank(505)
+            << ", RANK(2000) : " << m.rank(2000) << "\n";
+  std::cout << "COUNT_RANGE(100, 200) : " << m.count_range(100, 200)
+            << ", COUNT_RANGE(200, 100) : " << m.count_range(200, 100) << "\n";
+  RankedMap copy(m);
+  copy.erase(copy.begin(), copy.nth(5));
+  std::cout << "COPY NTH(0) : " << copy.nth(0)->first
+            << ", RANK(990) : " << copy.rank(990) << "\n";
+  ft::set<int, std::less<int>, std::allocator<int>, ft::order_statistics> s;
+  for (int i = 20; i > 0; --i) s.insert(i * i);
+  std::cout << "SET NTH(3) : " << *s.nth(3) << ", RANK(100) : " << s.rank(100)
+            << ", COUNT_RANGE(10, 101) : " << s.count_range(10, 101);
+  std::cout << "\n\n========================================\n\n";
+}
+
+template <typename Map>
+void PrintKeys(const std::string& name, const Map& m) {
+  std::cout << name << " (" << m.size() << ") :";
+  for (typename Map::const_iterator it = m.begin(); it != m.end(); ++it)
+    std::cout << " " << it->first;
+  std::cout << "\n";
+}
+
+void TestHeterogeneousLookup(void) {
+  std::cout << "MAP & SET - HETEROGENEOUS LOOKUP\n\n";
+  ft::map<std::string, int, ft::less<> > m;
+  m["apple"] = 1;
+  m["banana"] = 2;
+  m["cherry"] = 3;
+  const char* key = "banana";
+  std::cout << "FIND(\"banana\") : " << m.find(key)->second
+            << ", COUNT(\"kiwi\") : " << m.count("kiwi")
+            << ", LOWER_BOUND(\"b\") : " << m.lower_bound("b")->first
+            << ", UPPER_BOUND(\"banana\") : " << m.upper_bound(key)->first
+            << "\n";
+  std::cout << "EQUAL_RANGE(\"cherry\") : "
+            << m.equal_range("cherry").first->first << "\n";
+  ft::set<std::string, ft::less<> > s;
+  s.insert("x");
+  s.insert("y");
+  std::cout << "SET FIND(\"y\") : " << *s.find("y")
+            << ", COUNT(\"z\") : " << s.count("z");
+  std::cout << "\n\n========================================\n\n";
+}
+
+void TestSplitJoin(void) {
+  std::cout << "MAP & SET - SPLIT & JOIN\n\n";
+  ft::map<int, std::string> m;
+  for (int i = 0; i < 20; ++i) m[i * 5] = std::string(1, 'a' + i);
+  ft::map<int, std::string> greater;
+  greater[-1] = "cleared first";
+  m.split(42, greater);
+  PrintKeys("LESS", m);
+  PrintKeys("GREATER", greater);
+  ft::map<int, std::string> empty;
+  m.split(1000, empty);
+  PrintKeys("SPLIT PAST THE END", empty);
+  greater.split(45, empty);
+  PrintKeys("SPLIT AT BEGIN", greater);
+  PrintKeys("MOVED", empty);
+  empty.join(m);
+  PrintKeys("JOIN BEFORE", empty);
+  PrintKeys("JOINED", m);
+  m[1] = "one";
+  m[200] = "two hundred";
+  empty[1] = "taken";
+  empty[2] = "two";
+  m.join(empty);
+  PrintKeys("JOIN OVERLAPPING", m);
+  PrintKeys("LEFT IN OTHER", empty);
+  std::cout << "[1] : " << m[1] << ", [2] : " << m[2] << "\n";
+  for (int i = 0; i < 300; ++i) m[i] = "x";
+  m.erase(m.find(10), m.find(250));
+  PrintKeys("ERASE [10, 250)", m);
+  ft::set<int> s;
+  for (int i = 0; i < 10; ++i) s.insert(i);
+  ft::set<int> s2;
+  s.split(5, s2);
+  s2.join(s);
+  std::cout << "SET SIZES : " << s.size() << ", " << s2.size() << ", FRONT : "
+            << *s2.begin() << ", BACK : " << *s2.rbegin();
+  std::cout << "\n\n========================================\n\n";
+}
+
+// counts how a mapped value gets constructed
+struct Tally {
+  static int n_default;
+  static int n_copies;
+  static int n_from_int;
+
+  int value;
+
+  Tally(void) : value(0) { ++n_default; }
+  Tally(const Tally& other) : value(other.value) { ++n_copies; }
+  explicit Tally(int v) : value(v) { ++n_from_int; }
+};
+
+int Tally::n_default = 0;
+int Tally::n_copies = 0;
+int Tally::n_from_int = 0;
+
+void PrintTally(const std::string& name) {
+  std::cout << name << " : " << Tally::n_default << " DEFAULT, "
+            << Tally::n_copies << " COPIES, " << Tally::n_from_int
+            << " FROM INT\n";
+  Tally::n_default = 0;
+  Tally::n_copies = 0;
+  Tally::n_from_int = 0;
+}
+
+void TestTryEmplace(void) {
+  std::cout << "MAP - TRY_EMPLACE & INSERT_OR_ASSIGN\n\n";
+  ft::map<int, Tally> m;
+  m[1];
+  PrintTally("OPERATOR[] MISS");
+  m[1].value = 10;
+  PrintTally("OPERATOR[] HIT");
+  ft::pair<ft::map<int, Tally>::iterator, bool> ret = m.try_emplace(2, 20);
+  std::cout << "TRY_EMPLACE(2, 20) : " << ret.first->second.value << ", "
+            << (ret.second ? "INSERTED" : "FOUND") << "\n";
+  ret = m.try_emplace(2, 30);
+  std::cout << "TRY_EMPLACE(2, 30) : " << ret.first->second.value << ", "
+            << (ret.second ? "INSERTED" : "FOUND") << "\n";
+  PrintTally("TRY_EMPLACE");
+  m.try_emplace(m.end(), 3, 30);
+  m.try_emplace(m.begin(), 0);
+  PrintTally("TRY_EMPLACE WITH HINT");
+  ft::map<int, std::string> s;
+  ft::pair<ft::map<int, std::string>::iterator, bool> r2 =
+      s.insert_or_assign(1, "one");
+  std::cout << "INSERT_OR_ASSIGN(1, \"one\") : " << r2.first->second << ", "
+            << (r2.second ? "INSERTED" : "ASSIGNED") << "\n";
+  r2 = s.insert_or_assign(1, std::string("uno"));
+  std::cout << "INSERT_OR_ASSIGN(1, \"uno\") : " << r2.first->second << ", "
+            << (r2.second ? "INSERTED" : "ASSIGNED") << "\n";
+  s.insert_or_assign(s.end(), 2, "two");
+  std::cout << "SIZE : " << s.size() << ", BACK : " << s.rbegin()->second
+            << ", KEYS :";
+  for (ft::map<int, Tally>::iterator it = m.begin(); it != m.end(); ++it)
+    std::cout << " " << it->first << "=" << it->second.value;
+  std::cout << "\n\n========================================\n\n";
+}
+
+void TestThreaded(void) {
+  std::cout << "MAP & SET - THREADED\n\n";
+  typedef ft::map<int, int, std::less<int>,
+                  std::allocator<ft::pair<const int, int> >, ft::threaded>
+      ThreadedMap;
+  ThreadedMap m;
+  for (int i = 0; i < 20; ++i) m[(i * 7) % 20] = i;
+  m.erase(3);
+  m.erase(m.find(10), m.find(15));
+  ThreadedMap copy(m);
+  copy.insert(copy.end(), ft::make_pair(30, 0));
+  ThreadedMap greater;
+  copy.split(8, greater);
+  PrintKeys("THREADED MAP", m);
+  PrintKeys("SPLIT < 8", copy);
+  PrintKeys("SPLIT >= 8", greater);
+  greater.join(copy);
+  PrintKeys("JOINED", greater);
+  std::cout << "REVERSE :";
+  for (ThreadedMap::reverse_iterator it = greater.rbegin();
+       it != greater.rend(); ++it)
+    std::cout << " " << it->first;
+  std::cout << "\n";
+  ft::set<int, std::less<int>, std::allocator<int>, ft::threaded> s;
+  for (int i = 0; i < 10; ++i) s.insert(i * 3);
+  s.swap(s);
+  std::cout << "SET BACK : " << *--s.end() << ", FRONT : " << *s.begin();
+  std::cout << "\n\n========================================\n\n";
+}
+
+// a comparator with state : the order is picked at construction
+class Direction {
+ public:
+  explicit Direction(bool descending = false) : descending_(descending) {}
+
+  bool operator()(int x, int y) const { return descending_ ? y < x : x < y; }
+
+  bool descending(void) const { return descending_; }
+
+ private:
+  bool descending_;
+};
+
+void TestBTree(void) {
+  std::cout << "BTREE_MAP & BTREE_SET\n\n";
+  ft::btree_map<int, std::string> m;
+  for (int i = 0; i < 1000; ++i) m[(i * 37) % 1000] = "v";
+  for (int i = 0; i < 1000; i += 3) m.erase(i);
+  m.erase(m.find(101), m.find(899));
+  m.insert(m.end(), ft::make_pair(2000, std::string("last")));
+  m.insert(m.begin(), ft::make_pair(-1, std::string("first")));
+  ft::btree_map<int, std::string> copy(m);
+  copy.try_emplace(500, "five hundred");
+  std::cout << "SIZE : " << m.size() << ", COPY : " << copy.size()
+            << ", EQUAL : " << (copy == m) << "\n";
+  std::cout << "FRONT : " << m.begin()->second
+            << ", BACK : " << m.rbegin()->second << "\n";
+  std::cout << "LOWER_BOUND(500) : " << m.lower_bound(500)->first
+            << ", UPPER_BOUND(899) : " << m.upper_bound(899)->first
+            << ", COUNT(500) : " << copy.count(500) << "\n";
+  PrintKeys("BELOW 20", ft::btree_map<int, std::string>(
+                            m.begin(), m.lower_bound(20)));
+  ft::btree_set<std::string> s;
+  for (int i = 0; i < 300; ++i) s.insert(std::string(1, 'a' + i % 26) + "x");
+  std::cout << "SET SIZE : " << s.size() << ", FRONT : " << *s.begin()
+            << ", BACK : " << *--s.end() << "\n";
+  ft::btree_map<int, int, Direction> up;
+  ft::btree_map<int, int, Direction> down((Direction(true)));
+  ft::btree_set<int, Direction> up_set;
+  ft::btree_set<int, Direction> down_set((Direction(true)));
+  for (int i = 0; i < 5; ++i) {
+    up[i] = i;
+    down[i] = i;
+    up_set.insert(i);
+    down_set.insert(i);
+  }
+  up.swap(down);
+  up_set.swap(down_set);
+  up[5] = 5;
+  up_set.insert(5);
+  PrintKeys("SWAPPED TO DESCENDING", up);
+  std::cout << "KEY_COMP DESCENDING? : " << up.key_comp().descending()
+            << ", VALUE_COMP(1, 0) : "
+            << up.value_comp()(ft::make_pair(1, 0), ft::make_pair(0, 0))
+            << ", SET FRONT : " << *up_set.begin()
+            << ", SET KEY_COMP DESCENDING? : "
+            << up_set.key_comp().descending();
+  std::cout << "\n\n========================================\n\n";
+}
+
+void TestFlat(void) {
+  std::cout << "FLAT_MAP & FLAT_SET\n\n";
+  ft::vector<ft::pair<int, std::string> > pairs;
+  for (int i = 0; i < 40; ++i)
+    pairs.push_back(ft::make_pair((i * 7) % 30, std::string(1, 'a' + i % 26)));
+  ft::flat_map<int, std::string> m(pairs.begin(), pairs.end());
+  m.erase(3);
+  m.erase(m.find(10), m.find(15));
+  m[100] = "z";
+  m.insert(m.begin(), ft::make_pair(-1, std::string("first")));
+  m.insert_or_assign(0, "zero");
+  ft::flat_map<int, std::string> copy(m);
+  copy.insert(pairs.begin(), pairs.end());
+  std::cout << "SIZE : " << m.size() << ", COPY : " << copy.size()
+            << ", LESS : " << (m < copy) << "\n";
+  std::cout << "FRONT : " << m.begin()->second
+            << ", AT 0 : " << m.find(0)->second
+            << ", BACK : " << m.rbegin()->second << "\n";
+  std::cout << "LOWER_BOUND(10) : " << m.lower_bound(10)->first
+            << ", UPPER_BOUND(15) : " << m.upper_bound(15)->first
+            << ", COUNT(12) : " << m.count(12) << "\n";
+  PrintKeys("FLAT MAP", m);
+  PrintKeys("SORTED", ft::flat_map<int, std::string>(
+                          ft::sorted_unique, copy.begin(), copy.begin() + 5));
+  ft::flat_set<std::string> s;
+  for (int i = 0; i < 300; ++i) s.insert(std::string(1, 'a' + i % 26) + "x");
+  s.erase(s.begin());
+  std::cout << "SET SIZE : " << s.size() << ", FRONT : " << *s.begin()
+            << ", BACK : " << *--s.end();
+  std::cout << "\n\n========================================\n\n";
+}
+
+struct KeyPrinter {
+  template <typename Value>
+  void operator()(const Value& val) const {
+    std::cout << " " << val.first << "=" << val.second;
+  }
+};
+
+void TestConcurrentMap(void) {
+  std::cout << "CONCURRENT_MAP\n\n";
+  ft::concurrent_map<int, std::string> m(4);
+  for (int i = 0; i < 30; ++i)
+    m.insert(ft::make_pair((i * 7) % 30, std::string(1, 'a' + i % 26)));
+  m.erase(3);
+  m.insert_or_assign(0, "zero");
+  std::cout << "INSERTED TWICE : " << m.insert(ft::make_pair(1, std::string()))
+            << ", SIZE : " << m.size() << ", SHARDS : " << m.shard_count()
+            << "\n";
+  std::string found;
+  std::cout << "FIND(0) : " << m.find(0, found) << " " << found
+            << ", FIND(3) : " << m.find(3, found)
+            << ", COUNT(29) : " << m.count(29) << "\n";
+  std::cout << "IN ORDER :";
+  m.for_each(KeyPrinter());
+  std::cout << "\n[10, 15) :";
+  m.for_each_in_range(10, 15, KeyPrinter());
+  m.clear();
+  std::cout << "\nEMPTY AFTER CLEAR : " << m.empty();
+  std::cout << "\n\n========================================\n\n";
 }
 
+// SECTION : concurrent_map under threads
+// Writers all insert & assign the shared keys [0, 1000) with the same
+// values, and each owns the keys of [1000, 3000) equal to its id modulo
+// kWriters : it inserts them, then erases the multiples of 3. Whatever the
+// interleaving, the map ends up with the same elements, each mapped to twice
+// its key.
+typedef ft::concurrent_map<int, int> SharedMap;
+
+enum { kWriters = 4, kReaders = 2, kSharedKeys = 1000, kKeys = 3000 };
+
+struct SharedMapJob {
+  SharedMap* m;
+  int id;
+  bool ok;
+};
+
+// keys strictly increasing, each mapped to twice its key
+struct OrderChecker {
+  int last;
+  size_t n;
+  bool ok;
+
+  OrderChecker(void) : last(-1), n(0), ok(true) {}
+
+  void operator()(const SharedMap::value_type& val) {
+    if (val.first <= last || val.second != 2 * val.first) ok = false;
+    last = val.first;
+    ++n;
+  }
+};
+
+void* RunWriter(void* arg) {
+  SharedMapJob* job = static_cast<SharedMapJob*>(arg);
+  for (int i = 0; i < kSharedKeys; ++i) {
+    const int key = (i + job->id * 250) % kSharedKeys;
+    job->m->insert(ft::make_pair(key, 2 * key));
+    job->m->insert_or_assign(key, 2 * key);
+  }
+  for (int key = kSharedKeys + job->id; key < kKeys; key += kWriters)
+    job->m->insert(ft::make_pair(key, 2 * key));
+  for (int key = kSharedKeys + job->id; key < kKeys; key += kWriters)
+    if (key % 3 == 0 && job->m->erase(key) != 1) job->ok = false;
+  return NULL;
+}
+
+void* RunReader(void* arg) {
+  SharedMapJob* job = static_cast<SharedMapJob*>(arg);
+  for (int round = 0; round < 50; ++round) {
+    const int first = (round * 97 + job->id * 500) % kKeys;
+    if (!job->m->for_each_in_range(first, first + 400, OrderChecker()).ok)
+      job->ok = false;
+    int value = 0;
+    if (job->m->find(first, value) && value != 2 * first) job->ok = false;
+  }
+  return NULL;
+}
+
+void TestConcurrentMapThreads(void) {
+  std::cout << "CONCURRENT_MAP - WRITERS & READERS\n\n";
+  SharedMap m(8);
+  pthread_t tids[kWriters + kReaders];
+  SharedMapJob jobs[kWriters + kReaders];
+  for (int i = 0; i < kWriters + kReaders; ++i) {
+    jobs[i].m = &m;
+    jobs[i].id = (i < kWriters) ? i : i - kWriters;
+    jobs[i].ok = true;
+    pthread_create(&tids[i], NULL, (i < kWriters) ? RunWriter : RunReader,
+                   &jobs[i]);
+  }
+  bool ok = true;
+  for (int i = 0; i < kWriters + kReaders; ++i) {
+    pthread_join(tids[i], NULL);
+    ok = ok && jobs[i].ok;
+  }
+  const OrderChecker checker = m.for_each(OrderChecker());
+  size_t expected = kSharedKeys;
+  for (int key = kSharedKeys; key < kKeys; ++key) expected += (key % 3 != 0);
+  std::cout << "SIZE : " << m.size() << ", EXPECTED : " << expected
+            << ", VISITED IN ORDER : " << checker.n
+            << ", ORDERED & VALUES OK? : " << (checker.ok && ok ? "YES" : "NO")
+            << ", COUNT(999) : " << m.count(999)
+            << ", COUNT(1002) : " << m.count(1002);
+  std::cout << "\n\n========================================\n\n";
+}
+#endif
+
 int main(void) {
   TestVector();
+  TestVectorBool();
+  TestDeque();
   TestStack();
   TestMap();
   TestSet();
+#ifndef STD
+  TestEmptyDequeAllocation();
+  TestSmallVector();
+  TestEraseIf();
+  TestParallel();
+  TestBitOperations();
+  TestMappedVector();
+  TestNodePool();
+  TestSortedBuild();
+  TestOrderStatistics();
+  TestSplitJoin();
+  TestHeterogeneousLookup();
+  TestTryEmplace();
+  TestThreaded();
+  TestBTree();
+  TestFlat();
+  TestConcurrentMap();
+  TestConcurrentMapThreads();
+#endif
 
   // system("leaks ft_containers");
   return EXIT_SUCCESS;